@@ -0,0 +1,175 @@
+/*----------------------------------------------------------------------------
+    File name   : adcblock.c
+
+    Description : fills two alternating sample buffers from the A/D
+                  interrupt and hands complete blocks to the main loop, so
+                  filtering, statistics and display run once per block
+
+    Procesor    : Philips LPC2124 MCU with ARM7TDMI-s Core
+
+    Note        : Timer1 toggles MAT1.0 at twice the sample rate and each
+                  rising edge starts a conversion (ADCR START = 110), so
+                  sampling is jitter-free and costs one interrupt per
+                  sample. If the main loop still holds the previous block
+                  when the next one completes, the new block is dropped,
+                  refilled and counted as an overrun.
+
+                [Please refer to LPC2124 user manual, chapter "A/D converter"]
+ ----------------------------------------------------------------------------*/
+
+#include "NXP/iolpc2124.h"
+#include "../../interrupts/vic/inr.h"
+#include "adcblock.h"
+
+static unsigned short      adb_buf[2][ADB_BLOCK];
+static volatile int        adb_fill;         //Buffer the ISR writes
+static volatile int        adb_ready = -1;   //Buffer owned by the main loop, -1 = none
+static int                 adb_pos;
+static volatile unsigned int adb_overruns;
+
+/*-------------------------------------------------------------------------
+   Function Name: adb_isr
+
+   Parameters: None
+ 
+   Return:  None
+ 
+   Description: Stores one result (reading ADGDR clears the interrupt) and
+                swaps buffers when a block is complete
+ ---------------------------------------------------------------------------*/
+static void adb_isr(void)
+{
+  adb_buf[adb_fill][adb_pos++] = (ADGDR >> 6) & 0x3FF;
+
+  if(adb_pos == ADB_BLOCK)
+  {
+    adb_pos = 0;
+    if(adb_ready >= 0)
+    {
+      adb_overruns++;            //Main loop too slow, refill this buffer
+    }
+    else
+    {
+      adb_ready = adb_fill;
+      adb_fill ^= 1;
+    }
+  }
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: adcblock_init
+
+   Parameters: AD0 channel (0-3, PINSEL set up by the caller) and sample
+               rate in Hz
+ 
+   Return:  None
+ 
+   Description: Programs Timer1 as the conversion trigger and installs the
+                A/D interrupt. VIC_init() must have been called; sampling
+                starts once IRQs are enabled.
+ ---------------------------------------------------------------------------*/
+void adcblock_init(unsigned int channel, unsigned int rate_hz)
+{
+  adb_fill  = 0;
+  adb_ready = -1;
+  adb_pos   = 0;
+  adb_overruns = 0;
+
+  ADCR = (1 << channel)          //SEL
+       | (ADB_CLKDIV << 8)       //CLKDIV
+       | (1 << 21)               //PDN: A/D powered
+       | (6 << 24);              //START on MAT1.0 rising edge
+
+  install_IRQ(ADB_INT_NUMBER, adb_isr, ADB_VIC_SLOT);
+
+  T1TCR = 2;                                 //Reset and hold Timer1
+  T1PR  = 0;
+  T1MR0 = ADB_PCLK_HZ / (2 * rate_hz) - 1;   //Toggle period = half a sample
+  T1MCR = 2;                                 //Reset on MR0
+  T1EMR = 3 << 4;                            //Toggle MAT1.0 on MR0
+  T1TCR = 1;                                 //Run
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: adcblock_get / adcblock_release
+
+   Parameters: None
+ 
+   Return:  Full block of ADB_BLOCK samples, or 0 if none is ready yet
+ 
+   Description: The block stays valid until adcblock_release(); release it
+                before the other buffer fills to avoid overruns
+ ---------------------------------------------------------------------------*/
+const unsigned short *adcblock_get(void)
+{
+  int ready = adb_ready;
+
+  return ready >= 0 ? adb_buf[ready] : 0;
+}
+
+void adcblock_release(void)
+{
+  adb_ready = -1;
+}
+
+unsigned int adcblock_overruns(void)
+{
+  return adb_overruns;
+}
+
+//Integer square root (bit by bit)
+static unsigned int adb_isqrt(unsigned int v)
+{
+  unsigned int root = 0;
+  unsigned int bit  = 1UL << 30;
+
+  while(bit > v)
+    bit >>= 2;
+
+  while(bit)
+  {
+    if(v >= root + bit)
+    {
+      v   -= root + bit;
+      root = (root >> 1) + bit;
+    }
+    else
+    {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return root;
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: adcblock_stats
+
+   Parameters: Block, number of samples and result structure
+ 
+   Return:  None
+ 
+   Description: Min, max, mean and RMS in one pass, integer only
+ ---------------------------------------------------------------------------*/
+void adcblock_stats(const unsigned short *block, int n, adb_stats *st)
+{
+  unsigned int min = 0xFFFF;
+  unsigned int max = 0;
+  unsigned int sum = 0;
+  unsigned long long sumsq = 0;
+
+  for(int i = 0; i < n; i++)
+  {
+    unsigned int v = block[i];
+
+    if(v < min) min = v;
+    if(v > max) max = v;
+    sum   += v;
+    sumsq += v * v;
+  }
+
+  st->min  = min;
+  st->max  = max;
+  st->mean = n ? (sum + n / 2) / n : 0;
+  st->rms  = n ? adb_isqrt((unsigned int)(sumsq / n)) : 0;
+}
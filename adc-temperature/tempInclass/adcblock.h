@@ -0,0 +1,42 @@
+/*--------------------------------------------------------------
+ File:      adcblock.h
+ Purpose:   Ping-pong block acquisition from AD0 with block statistics
+ Compiler:  IAR EW 5.5
+ System:    Philips LPC2124 MCU with ARM7TDMI-s core
+----------------------------------------------------------------*/
+
+#ifndef   __ADCBLOCK_H
+#define   __ADCBLOCK_H
+
+#include "../../hal/board.h"
+
+//Macros
+#ifndef ADB_BLOCK
+#define ADB_BLOCK        64        //Samples per block (max 4096)
+#endif
+#define ADB_PCLK_HZ      BOARD_PCLK_HZ
+#define ADB_CLKDIV       12        //ADC clock = PCLK / 13 (must be <= 4.5 MHz)
+#define ADB_INT_NUMBER   18        //A/D converter interrupt source
+#define ADB_VIC_SLOT     2         //Vectored IRQ slot
+
+//Statistics of one block (ADC counts)
+typedef struct
+{
+  unsigned int min;
+  unsigned int max;
+  unsigned int mean;
+  unsigned int rms;
+} adb_stats;
+
+//Function Prototypes
+void adcblock_init(unsigned int channel, unsigned int rate_hz);
+
+const unsigned short *adcblock_get(void);
+
+void adcblock_release(void);
+
+unsigned int adcblock_overruns(void);
+
+void adcblock_stats(const unsigned short *block, int n, adb_stats *st);
+
+#endif //__ADCBLOCK_H
@@ -1,10 +1,18 @@
 #include <NXP/iolpc2124.h>
+#include "../../interrupts/vic/inr.h"
+#include "../../hal/gpio_bind.h"
+#include "tempconv.h"
+#include "adcblock.h"
 
+#define SAMPLE_RATE_HZ  1000    //ADB_BLOCK = 64 -> ~16 LED updates per second
+
+//Blocks dropped because the loop fell behind; watch it while debugging,
+//anything but 0 means the per-block work is too slow for SAMPLE_RATE_HZ
+volatile unsigned int adc_overruns;
 
 void delay_ms(unsigned int ms);
 void init_gpio();
 void init_adc();
-unsigned int read_adc();
 
 
 
@@ -12,11 +20,19 @@ unsigned int read_adc();
 void main(){
   init_gpio();
   delay_ms(50);
+  VIC_init();
   init_adc();
-  delay_ms(50);
+  __enable_interrupt();
   while(1){
-    IO0SET = read_adc();
-    delay_ms(50);
+    const unsigned short *block = adcblock_get();
+    if(block){
+      adb_stats st;
+      adcblock_stats(block, ADB_BLOCK, &st);   //Once per block, not per sample
+      adcblock_release();
+      adc_overruns = adcblock_overruns();
+      int centi = tc_lm35_centi(st.mean);      //LM35 on AD0.1 (P0.28)
+      gpio_write_masked(0x000000FF, centi < 0 ? 0 : centi / 100);   //Whole degrees on P0.0-7
+    }
   }
 }
 
@@ -30,24 +46,11 @@ void delay_ms(unsigned int ms) {
 
 void init_gpio(){
   PINSEL0 = 0;
-  IO0DIR= 0x000000FF;
+  gpio_init();
+  GPIO_DIR_OUT(0x000000FF);
 }
 
 void init_adc(){
-  PINSEL1_bit.P0_28 = 1;
-  ADCR_bit.SEL=2;
-  ADCR_bit.CLKDIV=12;
-  ADCR_bit.CLKS=2;
-  ADCR_bit.PDN=0;
+  PINSEL1_bit.P0_28 = 1;                     //P0.28 = AD0.1
+  adcblock_init(1, SAMPLE_RATE_HZ);
 }
-
-unsigned int read_adc(){
-  ADCR_bit.PDN = 1;
-  delay_ms(50);
-  ADCR_bit.START=1;
-  while(!(ADGDR_bit.DONE==1));
-  unsigned int res = ADGDR_bit.RESULT;
-  ADCR_bit.START=0;
-  ADCR_bit.PDN = 0;
-  return res;
-}
\ No newline at end of file
@@ -0,0 +1,104 @@
+/*----------------------------------------------------------------------------
+    File name   : tempconv.c
+
+    Description : converts raw ADC counts into temperature (centi-degrees C)
+                  using precomputed tables and one linear interpolation step.
+                  No floating point is used at run time.
+
+    Procesor    : Philips LPC2124 MCU with ARM7TDMI-s Core
+
+    Note        : Both tables assume Vref = 3.3 V and a 10-bit result
+                  (ADGDR_bit.RESULT). A table holds TC_ENTRIES points spaced
+                  TC_STEP counts apart, the last point being the (virtual)
+                  count 1024 so every 10-bit value has a right-hand neighbour.
+ ----------------------------------------------------------------------------*/
+
+#include "tempconv.h"
+
+/*
+   LM35: 10 mV/degC, so centi-degrees = counts * 3300 mV / 1024 * 10.
+   The table is generated by the compiler from this expression and clamped
+   at the sensor's 150 degC rating (keeps every entry inside a short).
+*/
+#define LM35_CD(i)   ((((i) * TC_STEP * 33000L) / 1024) > 15000 ? 15000 : \
+                      (((i) * TC_STEP * 33000L) / 1024))
+
+#define LM35_ROW(i)  LM35_CD(i), LM35_CD(i + 1), LM35_CD(i + 2), LM35_CD(i + 3), \
+                     LM35_CD(i + 4), LM35_CD(i + 5), LM35_CD(i + 6), LM35_CD(i + 7)
+
+const short tc_lm35_table[TC_ENTRIES] =
+{
+  LM35_ROW(0),  LM35_ROW(8),  LM35_ROW(16), LM35_ROW(24),
+  LM35_ROW(32), LM35_ROW(40), LM35_ROW(48), LM35_ROW(56),
+  LM35_CD(64)
+};
+
+/*
+   NTC thermistor: 10k @ 25 degC, B = 3950, NTC to ground with a 10k
+   pull-up to Vref. Points come from the Beta equation
+       T = 1 / (1/298.15 + ln(R/10k)/3950) - 273.15,  R = 10k * c / (1024 - c)
+   evaluated off-line (the log is not a constant expression) and clamped
+   to -55..150 degC. If the divider or thermistor changes, update the
+   NTC_xxx values in tempconv_host.c and paste the output of
+   "tempconv_host gen" here.
+*/
+const short tc_ntc_table[TC_ENTRIES] =
+{
+  15000, 15000, 12932, 11274, 10160,  9326,  8661,  8107,
+   7633,  7218,  6849,  6515,  6211,  5930,  5669,  5425,
+   5196,  4979,  4772,  4575,  4387,  4205,  4030,  3860,
+   3696,  3536,  3379,  3226,  3077,  2929,  2784,  2641,
+   2500,  2360,  2221,  2083,  1945,  1807,  1670,  1532,
+   1393,  1253,  1113,   970,   825,   678,   528,   375,
+    217,    54,  -114,  -288,  -471,  -663,  -867, -1084,
+  -1318, -1575, -1859, -2182, -2560, -3023, -3637, -4603,
+  -5500
+};
+
+/*-------------------------------------------------------------------------
+   Function Name: tc_lookup
+
+   Parameters: Conversion table and raw ADC counts (0..1023)
+ 
+   Return:  Temperature in centi-degrees Celsius
+ 
+   Description: Picks the table segment from the upper bits of the count and
+                interpolates linearly with the lower TC_STEP_SHIFT bits.
+                Costs one load pair, one multiply and one shift.
+ ---------------------------------------------------------------------------*/
+int tc_lookup(const short *table, unsigned int counts)
+{
+  unsigned int idx;
+  unsigned int frac;
+  int lo;
+
+  if(counts > (1 << TC_ADC_BITS) - 1)   //Clamp out-of-range input
+  {
+    counts = (1 << TC_ADC_BITS) - 1;
+  }
+
+  idx  = counts >> TC_STEP_SHIFT;
+  frac = counts & (TC_STEP - 1);
+  lo   = table[idx];
+
+  return lo + (((table[idx + 1] - lo) * (int)frac) >> TC_STEP_SHIFT);
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: tc_lm35_centi / tc_ntc_centi
+
+   Parameters: Raw ADC counts
+ 
+   Return:  Temperature in centi-degrees Celsius
+ 
+   Description: Convenience wrappers for the two built-in sensor tables
+ ---------------------------------------------------------------------------*/
+int tc_lm35_centi(unsigned int counts)
+{
+  return tc_lookup(tc_lm35_table, counts);
+}
+
+int tc_ntc_centi(unsigned int counts)
+{
+  return tc_lookup(tc_ntc_table, counts);
+}
@@ -0,0 +1,28 @@
+/*--------------------------------------------------------------
+ File:      tempconv.h
+ Purpose:   ADC count to temperature conversion (lookup tables)
+ Compiler:  IAR EW 5.5
+ System:    Philips LPC2124 MCU with ARM7TDMI-s core
+----------------------------------------------------------------*/
+
+#ifndef   __TEMPCONV_H
+#define   __TEMPCONV_H
+
+//Macros
+#define TC_ADC_BITS     10                       //ADC resolution (AD0 on LPC21xx)
+#define TC_STEP_SHIFT   4                        //Table step = 16 ADC counts
+#define TC_STEP         (1 << TC_STEP_SHIFT)
+#define TC_ENTRIES      ((1 << (TC_ADC_BITS - TC_STEP_SHIFT)) + 1)  //65 points, 0..1024 counts
+
+//Sensor tables, centi-degrees Celsius at counts 0, 16, 32 ... 1024
+extern const short tc_lm35_table[TC_ENTRIES];
+extern const short tc_ntc_table[TC_ENTRIES];
+
+//Function Prototypes
+int tc_lookup(const short *table, unsigned int counts);
+
+int tc_lm35_centi(unsigned int counts);
+
+int tc_ntc_centi(unsigned int counts);
+
+#endif //__TEMPCONV_H
@@ -0,0 +1,125 @@
+/*----------------------------------------------------------------------------
+    File name   : tempconv_host.c
+
+    Description : host check for tempconv.c. Compares both lookup tables
+                  against the floating-point sensor equations (max error)
+                  and times a table conversion against the float
+                  reference. With "gen" as argument it prints a fresh
+                  tc_ntc_table from the NTC_xxx parameters below.
+
+    Procesor    : host PC
+
+    Note        : Build and run from adc-temperature/tempInclass:
+
+      cc -O2 tempconv_host.c tempconv.c -lm -o tempconv_host
+      ./tempconv_host          accuracy and ns per conversion
+      ./tempconv_host gen      table to paste into tempconv.c
+
+                  Host timings only compare the two methods; on the
+                  ARM7 the float path is software emulated and far slower.
+ ----------------------------------------------------------------------------*/
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "tempconv.h"
+
+//NTC divider the table is generated for (see tempconv.c)
+#define NTC_R0      10000.0   //Thermistor at 25 degC, ohm
+#define NTC_BETA    3950.0
+#define NTC_RFIX    10000.0   //Pull-up to Vref, ohm
+#define NTC_TMIN    -55.0     //Clamp range, degC
+#define NTC_TMAX    150.0
+
+#define LOOPS       2000000
+
+//Float references, centi-degrees
+static double ref_lm35(unsigned int c)
+{
+  double t = c * 3300.0 / 1024.0 * 10.0;
+  return t > 15000.0 ? 15000.0 : t;
+}
+
+static double ref_ntc(unsigned int c)
+{
+  double t;
+
+  if(c == 0)
+    return NTC_TMAX * 100.0;
+  if(c >= 1024)
+    return NTC_TMIN * 100.0;
+
+  t = 1.0 / (1.0 / 298.15 + log(NTC_RFIX * c / (1024 - c) / NTC_R0) / NTC_BETA) - 273.15;
+  if(t < NTC_TMIN) t = NTC_TMIN;
+  if(t > NTC_TMAX) t = NTC_TMAX;
+  return t * 100.0;
+}
+
+static void gen_ntc(void)
+{
+  printf("const short tc_ntc_table[TC_ENTRIES] =\n{\n");
+  for(int i = 0; i < TC_ENTRIES; i++)
+  {
+    printf("%s%6ld%s", i % 8 ? "" : " ", lround(ref_ntc(i * TC_STEP)),
+           i == TC_ENTRIES - 1 ? "\n" : (i % 8 == 7 ? ",\n" : ","));
+  }
+  printf("};\n");
+}
+
+static double max_error(int (*conv)(unsigned int), double (*ref)(unsigned int),
+                        unsigned int lo, unsigned int hi, unsigned int *at)
+{
+  double worst = 0.0;
+
+  for(unsigned int c = lo; c <= hi; c++)
+  {
+    double e = fabs(conv(c) - ref(c));
+    if(e > worst)
+    {
+      worst = e;
+      *at = c;
+    }
+  }
+  return worst / 100.0;
+}
+
+static double ns_per_call_table(void)
+{
+  volatile int sink = 0;
+  clock_t t0 = clock();
+
+  for(unsigned int i = 0; i < LOOPS; i++)
+    sink += tc_ntc_centi(i & 0x3FF);
+  return (double)(clock() - t0) / CLOCKS_PER_SEC * 1e9 / LOOPS;
+}
+
+static double ns_per_call_float(void)
+{
+  volatile double sink = 0;
+  clock_t t0 = clock();
+
+  for(unsigned int i = 0; i < LOOPS; i++)
+    sink += ref_ntc((i & 0x3FF) | 1);
+  return (double)(clock() - t0) / CLOCKS_PER_SEC * 1e9 / LOOPS;
+}
+
+int main(int argc, char **argv)
+{
+  unsigned int at = 0;
+
+  if(argc > 1 && strcmp(argv[1], "gen") == 0)
+  {
+    gen_ntc();
+    return 0;
+  }
+
+  printf("LM35 max error %.2f degC", max_error(tc_lm35_centi, ref_lm35, 0, 1023, &at));
+  printf(" (at %u counts)\n", at);
+  //NTC ends are clamped and steep; report counts 48..990 (about -45..130 degC)
+  printf("NTC  max error %.2f degC", max_error(tc_ntc_centi, ref_ntc, 48, 990, &at));
+  printf(" (at %u counts, range 48..990)\n", at);
+  printf("table lookup   %6.1f ns/conversion\n", ns_per_call_table());
+  printf("float equation %6.1f ns/conversion\n", ns_per_call_float());
+  return 0;
+}
@@ -1,35 +1,38 @@
 #include "NXP/iolpc2124.h"
+#include "../../interrupts/vic/inr.h"
+#include "../../hal/gpio_bind.h"
+#include "adcblock.h"
 
-// Function to read ADC value from pin 27 (assumed to be AD0.2)
-uint16_t ReadADC(void) {
-    // Configure and start ADC conversion
-    ADCR = (1 << 2) |    // Select channel 2 (AD0.2)
-           (4 << 8)  |    // CLKDIV = 4 (adjust based on clock frequency)
-           (1 << 21) |    // Power up ADC
-           (1 << 24);     // Start conversion now
+#define SAMPLE_RATE_HZ  1000    // ADB_BLOCK = 64 -> ~16 LED updates per second
 
-    // Wait for conversion to complete
-    while (!(ADGDR & (1 << 31))); // Check DONE bit
-
-    // Extract and return result (10-bit value)
-    return (ADGDR >> 6) & 0x3FF;
-}
+// Blocks dropped because the loop below fell behind (Watch window)
+volatile unsigned int adc_overruns;
 
 int main(void) {
     // Configure GPIO pins 0-7 as outputs
-    IO0DIR = 0xFF;
+    gpio_init();
+    GPIO_DIR_OUT(0xFF);
+
+    // Pin 27 of the package is P0.29 = AD0.2; blocks are sampled by
+    // Timer1 and the A/D interrupt instead of polling ADGDR
+    PINSEL1_bit.P0_29 = 1;
+    VIC_init();
+    adcblock_init(2, SAMPLE_RATE_HZ);
+    __enable_interrupt();
 
     while(1) {
-        // Read ADC value
-        uint16_t adc_value = ReadADC();
-        
-        // Convert 10-bit value to 8-bit (scale for LEDs)
-        uint8_t led_pattern = (adc_value >> 2); // Simple scaling
-        
-        // Update LEDs
-        IOPIN0 = (IOPIN0 & ~0xFF) | (led_pattern & 0xFF);
+        const unsigned short *block = adcblock_get();
+        if(block) {
+            adb_stats st;
+            adcblock_stats(block, ADB_BLOCK, &st);
+            adcblock_release();
+            adc_overruns = adcblock_overruns();
 
-        // Simple delay
-        for(volatile int i = 0; i < 100000; i++);
+            // Convert 10-bit mean to 8-bit (scale for LEDs)
+            unsigned char led_pattern = (st.mean >> 2); // Simple scaling
+            
+            // Update LEDs (masked clear/set, no read-modify-write of IOPIN0)
+            gpio_write_masked(0xFF, led_pattern);
+        }
     }
-}
\ No newline at end of file
+}
@@ -1,4 +1,7 @@
 #include<NXP/iolpc2124.h>
+#include "../../hal/gpio_bind.h"
+
+#define LED   GPIO_BIT(0)   //P0.0
 void init(void);
 void on_off(void);
 void delay(unsigned int);
@@ -15,14 +18,15 @@ void main()
 void init()
 {
   PINSEL0_bit.P0_0=0;
-  IO0DIR_bit.P0_0=1;
+  gpio_init();
+  GPIO_DIR_OUT(LED);
 }
 
 void on_off()
 {
-  IO0CLR_bit.P0_0=1;
+  GPIO_CLR(LED);
   delay(100000);
-  IO0SET_bit.P0_0=1;
+  GPIO_SET(LED);
   delay(100000);
 }
 
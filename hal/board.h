@@ -0,0 +1,21 @@
+/*--------------------------------------------------------------
+ File:      board.h
+ Purpose:   Clock frequencies shared by the projects
+ Compiler:  IAR EW 5.5
+ System:    Philips LPC2124/LPC2148 MCU with ARM7TDMI-s core
+----------------------------------------------------------------*/
+
+//If this file is not included by another program, define it here (avoids multiple definitions)
+#ifndef   __BOARD_H
+#define   __BOARD_H
+
+/*
+   No project starts the PLL or writes VPBDIV, so the core runs from the
+   12 MHz crystal and the peripherals at the VPBDIV reset value, CCLK/4.
+   Timer prescalers, PWM periods and the ADC divider are all derived from
+   BOARD_PCLK_HZ; change it here if a project changes the clocks.
+*/
+#define BOARD_CCLK_HZ    12000000                //Crystal, PLL off
+#define BOARD_PCLK_HZ    (BOARD_CCLK_HZ / 4)     //VPBDIV reset value: 3 MHz
+
+#endif //__BOARD_H
@@ -0,0 +1,107 @@
+/*--------------------------------------------------------------
+ File:      gpio_bind.h
+ Purpose:   Header-only GPIO port binding (port 0 set/clear stores)
+ Compiler:  IAR EW 5.5
+ System:    Philips LPC2124/LPC2148 MCU with ARM7TDMI-s core
+----------------------------------------------------------------*/
+
+//If this file is not included by another program, define it here (avoids multiple definitions)
+#ifndef   __GPIO_BIND_H
+#define   __GPIO_BIND_H
+
+/*
+   Every port 0 access in the projects goes through GPIO_SET/GPIO_CLR,
+   GPIO_READ and GPIO_DIR_OUT/GPIO_DIR_IN so the register backend can be
+   swapped in one place:
+
+     default            legacy VPB registers IO0SET/IO0CLR (LPC2124/2148)
+     GPIO_BACKEND_FIO   fast GPIO on the local bus, FIO0SET/FIO0CLR and
+                        FIO0MASK/FIO0PIN (LPC2148 and later parts only).
+                        Once enabled the legacy IO0xxx registers no longer
+                        drive port 0, so all port 0 code must use this file.
+
+   A host build may define all five macros before including this file to
+   capture the stores.
+*/
+#if defined(GPIO_SET)
+//Backend supplied by the includer
+#elif defined(GPIO_BACKEND_FIO)
+#include <intrinsics.h>
+#define GPIO_FIO_ACTIVE   1
+//By address, so this works next to either iolpc2124.h or iolpc2148.h
+#define GPIO_SCS          (*(volatile unsigned long *)0xE01FC1A0)
+#define GPIO_FIO0DIR      (*(volatile unsigned long *)0x3FFFC000)
+#define GPIO_FIO0MASK     (*(volatile unsigned long *)0x3FFFC010)
+#define GPIO_FIO0PIN      (*(volatile unsigned long *)0x3FFFC014)
+#define GPIO_FIO0SET      (*(volatile unsigned long *)0x3FFFC018)
+#define GPIO_FIO0CLR      (*(volatile unsigned long *)0x3FFFC01C)
+#define GPIO_SET(m)       (GPIO_FIO0SET = (m))
+#define GPIO_CLR(m)       (GPIO_FIO0CLR = (m))
+#define GPIO_READ()       (GPIO_FIO0PIN)
+#define GPIO_DIR_OUT(m)   (GPIO_FIO0DIR |= (m))
+#define GPIO_DIR_IN(m)    (GPIO_FIO0DIR &= ~(m))
+#else
+#include "NXP/iolpc2124.h"
+#define GPIO_SET(m)       (IO0SET = (m))     //Drive pins in mask high
+#define GPIO_CLR(m)       (IO0CLR = (m))     //Drive pins in mask low
+#define GPIO_READ()       (IO0PIN)           //Pin levels of the whole port
+#define GPIO_DIR_OUT(m)   (IO0DIR |= (m))    //Make pins in mask outputs
+#define GPIO_DIR_IN(m)    (IO0DIR &= ~(m))   //Make pins in mask inputs
+#endif
+
+#define GPIO_BIT(pin)     (1UL << (pin))
+
+/*-------------------------------------------------------------------------
+   Function Name: gpio_init
+
+   Parameters: None
+ 
+   Return:  None
+ 
+   Description: FIO backend: switches port 0 to high-speed GPIO (SCS.GPIO0M)
+                and clears FIO0MASK. Pin levels and directions do not carry
+                over, so call it before setting IO0DIR. No-op otherwise.
+ ---------------------------------------------------------------------------*/
+static inline void gpio_init(void)
+{
+#ifdef GPIO_FIO_ACTIVE
+  GPIO_SCS |= 1;
+  GPIO_FIO0MASK = 0;
+#endif
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: gpio_write_masked
+
+   Parameters: Pin mask and new value (already shifted into place)
+ 
+   Return:  None
+ 
+   Description: Writes a multi-bit field without touching other pins and
+                without a read-modify-write of IOPIN.
+                Legacy: one IOCLR and one IOSET store (a constant zero half
+                is folded away).
+                FIO: FIO0MASK hides the other pins and a single FIO0PIN
+                store updates the whole field at once; interrupts are held
+                off so no ISR sees the temporary mask.
+ ---------------------------------------------------------------------------*/
+static inline void gpio_write_masked(unsigned long mask, unsigned long value)
+{
+#ifdef GPIO_FIO_ACTIVE
+  __istate_t state = __get_interrupt_state();
+
+  __disable_interrupt();
+  GPIO_FIO0MASK = ~mask;
+  GPIO_FIO0PIN  = value;
+  GPIO_FIO0MASK = 0;
+  __set_interrupt_state(state);
+#else
+  unsigned long set = value & mask;
+  unsigned long clr = ~value & mask;
+
+  if(clr) GPIO_CLR(clr);
+  if(set) GPIO_SET(set);
+#endif
+}
+
+#endif //__GPIO_BIND_H
@@ -0,0 +1,167 @@
+/*--------------------------------------------------------------
+ File:      lcd_bind.h
+ Purpose:   Header-only HD44780 pin binding, resolved at compile time
+ Compiler:  IAR EW 5.5
+ System:    Philips LPC2124/LPC2148 MCU with ARM7TDMI-s core
+----------------------------------------------------------------*/
+
+//If this file is not included by another program, define it here (avoids multiple definitions)
+#ifndef   __LCD_BIND_H
+#define   __LCD_BIND_H
+
+#include "gpio_bind.h"
+
+/*
+   Select a board before including this file, e.g.
+
+       #define LCD_BOARD_PROJJ
+       #include "../../hal/lcd_bind.h"
+
+   or define LCD_BUS_WIDTH, LCD_PIN_RS, LCD_PIN_E, (optional) LCD_PIN_RW and
+   the data pins yourself. All masks below are constants, so each bus
+   access compiles to a fixed number of GPIO stores.
+*/
+#if defined(LCD_BOARD_HELLO)          //lcd/display-hello: 4-bit on P0.0-3
+  #define LCD_BUS_WIDTH  4
+  #define LCD_PIN_RS     4
+  #define LCD_PIN_E      5
+  #define LCD_PIN_D4     0
+  #define LCD_PIN_D5     1
+  #define LCD_PIN_D6     2
+  #define LCD_PIN_D7     3
+#elif defined(LCD_BOARD_PROJJ)        //lcd/teachLDC-lib/projj.c: 4-bit on P0.3-6, RW wired
+  #define LCD_BUS_WIDTH  4
+  #define LCD_PIN_RS     0
+  #define LCD_PIN_RW     1
+  #define LCD_PIN_E      2
+  #define LCD_PIN_D4     3
+  #define LCD_PIN_D5     4
+  #define LCD_PIN_D6     5
+  #define LCD_PIN_D7     6
+#elif defined(LCD_BOARD_TEACH)        //lcd/teachLDC-lib/lcd.c: 8-bit on P0.0-7
+  #define LCD_BUS_WIDTH  8
+  #define LCD_PIN_RS     8
+  #define LCD_PIN_RW     9
+  #define LCD_PIN_E      10
+  #define LCD_PIN_D0     0
+  #define LCD_PIN_D1     1
+  #define LCD_PIN_D2     2
+  #define LCD_PIN_D3     3
+  #define LCD_PIN_D4     4
+  #define LCD_PIN_D5     5
+  #define LCD_PIN_D6     6
+  #define LCD_PIN_D7     7
+#endif
+
+#if !defined(LCD_BUS_WIDTH) || !defined(LCD_PIN_RS) || !defined(LCD_PIN_E)
+#error "lcd_bind.h: select an LCD_BOARD_xxx or define the LCD pins"
+#endif
+
+//Control masks
+#define LCD_MASK_RS    GPIO_BIT(LCD_PIN_RS)
+#define LCD_MASK_E     GPIO_BIT(LCD_PIN_E)
+#ifdef LCD_PIN_RW
+#define LCD_MASK_RW    GPIO_BIT(LCD_PIN_RW)
+#else
+#define LCD_MASK_RW    0UL                   //RW tied low on the board
+#endif
+
+//Upper nibble (D4-D7) spread onto its pins
+#if (LCD_PIN_D5 == LCD_PIN_D4 + 1) && (LCD_PIN_D6 == LCD_PIN_D4 + 2) && \
+    (LCD_PIN_D7 == LCD_PIN_D4 + 3)
+#define LCD_HI_BITS(n) (((unsigned long)(n) & 0xFUL) << LCD_PIN_D4)
+#else
+#define LCD_HI_BITS(n) ((((n) & 1) ? GPIO_BIT(LCD_PIN_D4) : 0UL) | \
+                        (((n) & 2) ? GPIO_BIT(LCD_PIN_D5) : 0UL) | \
+                        (((n) & 4) ? GPIO_BIT(LCD_PIN_D6) : 0UL) | \
+                        (((n) & 8) ? GPIO_BIT(LCD_PIN_D7) : 0UL))
+#endif
+
+#if LCD_BUS_WIDTH == 8
+//Full byte (D0-D7) spread onto its pins
+#if (LCD_PIN_D1 == LCD_PIN_D0 + 1) && (LCD_PIN_D2 == LCD_PIN_D0 + 2) && \
+    (LCD_PIN_D3 == LCD_PIN_D0 + 3) && (LCD_PIN_D4 == LCD_PIN_D0 + 4) && \
+    (LCD_PIN_D5 == LCD_PIN_D0 + 5) && (LCD_PIN_D6 == LCD_PIN_D0 + 6) && \
+    (LCD_PIN_D7 == LCD_PIN_D0 + 7)
+#define LCD_DATA_BITS(v) (((unsigned long)(v) & 0xFFUL) << LCD_PIN_D0)
+#else
+#define LCD_DATA_BITS(v) ((((v) & 1) ? GPIO_BIT(LCD_PIN_D0) : 0UL) | \
+                          (((v) & 2) ? GPIO_BIT(LCD_PIN_D1) : 0UL) | \
+                          (((v) & 4) ? GPIO_BIT(LCD_PIN_D2) : 0UL) | \
+                          (((v) & 8) ? GPIO_BIT(LCD_PIN_D3) : 0UL) | \
+                          LCD_HI_BITS((v) >> 4))
+#endif
+#else
+#define LCD_DATA_BITS(v) LCD_HI_BITS(v)        //4-bit bus carries one nibble
+#endif
+
+#define LCD_MASK_DATA  LCD_DATA_BITS(LCD_BUS_WIDTH == 8 ? 0xFF : 0x0F)
+#define LCD_MASK_ALL   (LCD_MASK_RS | LCD_MASK_RW | LCD_MASK_E | LCD_MASK_DATA)
+
+/*-------------------------------------------------------------------------
+   Function Name: lcd_bus_init
+
+   Parameters: None
+ 
+   Return:  None
+ 
+   Description: Makes the LCD pins outputs and parks them low (E idle low,
+                RW in write mode). PINSEL is left to the caller.
+ ---------------------------------------------------------------------------*/
+static inline void lcd_bus_init(void)
+{
+  gpio_init();
+  GPIO_DIR_OUT(LCD_MASK_ALL);
+  GPIO_CLR(LCD_MASK_ALL);
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: lcd_bus_setup
+
+   Parameters: Register select (0 = command, 1 = data) and bus value
+               (a nibble on a 4-bit bus, a byte on an 8-bit bus)
+ 
+   Return:  None
+ 
+   Description: Presents RS, RW=0 and the data lines before an enable
+                pulse: one IO0CLR and one IO0SET store, or a single masked
+                FIO0PIN store with the FIO backend.
+ ---------------------------------------------------------------------------*/
+static inline void lcd_bus_setup(int rs, unsigned int value)
+{
+  unsigned long set = LCD_DATA_BITS(value) | (rs ? LCD_MASK_RS : 0UL);
+
+  gpio_write_masked(LCD_MASK_RS | LCD_MASK_RW | LCD_MASK_DATA, set);
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: lcd_bus_data_e_high
+
+   Parameters: Bus value
+ 
+   Return:  None
+ 
+   Description: Changes only the data lines and raises E in the same store.
+                Data only has to be valid before the falling edge of E, so
+                this is used for the second nibble when RS is already set.
+ ---------------------------------------------------------------------------*/
+static inline void lcd_bus_data_e_high(unsigned int value)
+{
+  unsigned long set = LCD_DATA_BITS(value);
+
+  GPIO_CLR(LCD_MASK_DATA & ~set);
+  GPIO_SET(set | LCD_MASK_E);
+}
+
+//Enable strobe edges (one store each)
+static inline void lcd_bus_e_high(void)
+{
+  GPIO_SET(LCD_MASK_E);
+}
+
+static inline void lcd_bus_e_low(void)
+{
+  GPIO_CLR(LCD_MASK_E);
+}
+
+#endif //__LCD_BIND_H
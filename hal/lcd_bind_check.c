@@ -0,0 +1,178 @@
+/*----------------------------------------------------------------------------
+    File name   : lcd_bind_check.c
+
+    Description : host check of the GPIO stores emitted by lcd_bind.h. The
+                  GPIO_SET/GPIO_CLR hooks record every store, and the
+                  sequence is compared with the expected masks for one
+                  board layout.
+
+    Procesor    : host PC
+
+    Note        : Build and run once per layout from the repository root.
+                  LCD_CUSTOM8 is an 8-bit bus with D0-D4 contiguous and
+                  D5-D7 elsewhere; no LCD_BOARD_xxx at all is a scattered
+                  4-bit layout. Both exercise the bit-by-bit spreading:
+
+      for b in LCD_BOARD_HELLO LCD_BOARD_PROJJ LCD_BOARD_TEACH LCD_CUSTOM8 LCD_CUSTOM; do
+        cc -D$b hal/lcd_bind_check.c -o lcd_bind_check && ./lcd_bind_check
+      done
+
+                  Exit status is non-zero on the first mismatch.
+ ----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MAX_STORES  8
+
+static int           n_stores;
+static char          kind[MAX_STORES];     //'S' = IO0SET, 'C' = IO0CLR
+static unsigned long mask[MAX_STORES];
+
+static void record(char k, unsigned long m)
+{
+  if(n_stores < MAX_STORES)
+  {
+    kind[n_stores] = k;
+    mask[n_stores] = m;
+  }
+  n_stores++;
+}
+
+#define GPIO_SET(m)       record('S', (m))
+#define GPIO_CLR(m)       record('C', (m))
+#define GPIO_DIR_OUT(m)   ((void)(m))
+#define GPIO_DIR_IN(m)    ((void)(m))
+#define GPIO_READ()       0UL
+
+#if defined(LCD_CUSTOM8)
+#define LCD_BUS_WIDTH  8
+#define LCD_PIN_RS     8
+#define LCD_PIN_RW     9
+#define LCD_PIN_E      10
+#define LCD_PIN_D0     0
+#define LCD_PIN_D1     1
+#define LCD_PIN_D2     2
+#define LCD_PIN_D3     3
+#define LCD_PIN_D4     4
+#define LCD_PIN_D5     12
+#define LCD_PIN_D6     13
+#define LCD_PIN_D7     14
+#define BOARD_NAME     "custom 8-bit (D5-D7 on P0.12-14)"
+#elif !defined(LCD_BOARD_HELLO) && !defined(LCD_BOARD_PROJJ) && !defined(LCD_BOARD_TEACH)
+#define LCD_BUS_WIDTH  4
+#define LCD_PIN_RS     20
+#define LCD_PIN_E      21
+#define LCD_PIN_D4     12
+#define LCD_PIN_D5     9
+#define LCD_PIN_D6     15
+#define LCD_PIN_D7     2
+#define BOARD_NAME     "custom (scattered pins)"
+#endif
+
+#include "lcd_bind.h"
+
+/*
+   Expected stores per layout:
+     setup1 = lcd_bus_setup(1, 0xA5)   (nibble 0x5 on a 4-bit bus)
+     setup0 = lcd_bus_setup(0, 0x00)   (nothing to set: one store)
+     data_e = lcd_bus_data_e_high(0x3)
+*/
+#if defined(LCD_BOARD_HELLO)
+#define BOARD_NAME  "LCD_BOARD_HELLO"
+#define ALL         0x3FUL
+static const char          setup1_k[] = "CS"; static const unsigned long setup1_m[] = { 0x00A, 0x015 };
+static const char          setup0_k[] = "C";  static const unsigned long setup0_m[] = { 0x01F };
+static const char          data_e_k[] = "CS"; static const unsigned long data_e_m[] = { 0x00C, 0x023 };
+#elif defined(LCD_BOARD_PROJJ)
+#define BOARD_NAME  "LCD_BOARD_PROJJ"
+#define ALL         0x7FUL
+static const char          setup1_k[] = "CS"; static const unsigned long setup1_m[] = { 0x052, 0x029 };
+static const char          setup0_k[] = "C";  static const unsigned long setup0_m[] = { 0x07B };
+static const char          data_e_k[] = "CS"; static const unsigned long data_e_m[] = { 0x060, 0x01C };
+#elif defined(LCD_BOARD_TEACH)
+#define BOARD_NAME  "LCD_BOARD_TEACH"
+#define ALL         0x7FFUL
+static const char          setup1_k[] = "CS"; static const unsigned long setup1_m[] = { 0x25A, 0x1A5 };
+static const char          setup0_k[] = "C";  static const unsigned long setup0_m[] = { 0x3FF };
+static const char          data_e_k[] = "CS"; static const unsigned long data_e_m[] = { 0x0FC, 0x403 };
+#elif defined(LCD_CUSTOM8)
+#define ALL         0x771FUL
+static const char          setup1_k[] = "CS"; static const unsigned long setup1_m[] = { 0x221A, 0x5105 };
+static const char          setup0_k[] = "C";  static const unsigned long setup0_m[] = { 0x731F };
+static const char          data_e_k[] = "CS"; static const unsigned long data_e_m[] = { 0x701C, 0x0403 };
+#else
+#define ALL         0x309204UL
+static const char          setup1_k[] = "CS"; static const unsigned long setup1_m[] = { 0x000204, 0x109000 };
+static const char          setup0_k[] = "C";  static const unsigned long setup0_m[] = { 0x109204 };
+static const char          data_e_k[] = "CS"; static const unsigned long data_e_m[] = { 0x008004, 0x201200 };
+#endif
+
+static int failures;
+
+static void expect(const char *what, const char *k, const unsigned long *m)
+{
+  int n = 0;
+
+  while(k[n])
+    n++;
+
+  if(n_stores != n)
+  {
+    printf("  %-8s %d stores, expected %d\n", what, n_stores, n);
+    failures++;
+    return;
+  }
+  for(int i = 0; i < n; i++)
+  {
+    if(kind[i] != k[i] || mask[i] != m[i])
+    {
+      printf("  %-8s store %d: IO0%s 0x%08lX, expected IO0%s 0x%08lX\n", what, i,
+             kind[i] == 'S' ? "SET" : "CLR", mask[i], k[i] == 'S' ? "SET" : "CLR", m[i]);
+      failures++;
+    }
+  }
+}
+
+int main(void)
+{
+  printf("%s\n", BOARD_NAME);
+
+  if(LCD_MASK_ALL != ALL)
+  {
+    printf("  LCD_MASK_ALL 0x%08lX, expected 0x%08lX\n", LCD_MASK_ALL, ALL);
+    failures++;
+  }
+
+#ifdef LCD_CUSTOM8
+  if(LCD_DATA_BITS(0xE0) != 0x7000UL)
+  {
+    printf("  LCD_DATA_BITS(0xE0) 0x%08lX, expected 0x00007000\n", LCD_DATA_BITS(0xE0));
+    failures++;
+  }
+#endif
+
+  n_stores = 0;
+  lcd_bus_setup(1, 0xA5);
+  expect("setup1", setup1_k, setup1_m);
+
+  n_stores = 0;
+  lcd_bus_setup(0, 0x00);
+  expect("setup0", setup0_k, setup0_m);
+
+  n_stores = 0;
+  lcd_bus_data_e_high(0x3);
+  expect("data_e", data_e_k, data_e_m);
+
+  n_stores = 0;
+  lcd_bus_e_high();
+  lcd_bus_e_low();
+  if(n_stores != 2 || mask[0] != LCD_MASK_E || mask[1] != LCD_MASK_E)
+  {
+    printf("  E strobe not two single-bit stores\n");
+    failures++;
+  }
+
+  printf("  %s\n", failures ? "FAILED" : "ok");
+  return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -21,4 +21,7 @@ void install_IRQ(unsigned int IntNumber,  void (*ISR)(void), unsigned int channe
 
 void install_FIQ(unsigned int IntNumber,  void (*ISR)(void));
 
+//Interrupted PC, valid while the FIQ ISR runs
+extern volatile unsigned int fiq_return_pc;
+
 #endif //__INTERRUPTS_H
@@ -26,6 +26,8 @@
 void DefVectISR(void);          //Default ISR for non-vectored IRQ
 static void (* fiq_isr)(void);  //FIQ ISR (there can only be one FIQ)
 
+volatile unsigned int fiq_return_pc;  //Address the current FIQ interrupted
+
 /*-------------------------------------------------------------------------
    Function Name: VIC_init
 
@@ -130,10 +132,12 @@ __irq __arm void IRQ_Handler(void)
  
   Return       : None
  
-  Description  : The FIQ Handler
+  Description  : The FIQ Handler. Records where the CPU was interrupted so
+                the FIQ ISR can use it (e.g. for PC sampling).
  ---------------------------------------------------------------------------*/
 __fiq __arm void FIQ_Handler(void)
 {
+  fiq_return_pc = __get_LR() - 4;            //LR_fiq = interrupted PC + 4
   (* fiq_isr)();                             //Call ISR
 }
 /*---------------------------------------------------------------------------
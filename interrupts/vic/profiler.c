@@ -0,0 +1,225 @@
+/*----------------------------------------------------------------------------
+    File name   : profiler.c
+
+    Description : function-level cycle profiler with two modes sharing one
+                  free-running Timer1:
+                  - instrumented: prof_enter()/prof_exit() markers record
+                    count, total and worst-case ticks per region id
+                  - sampled: a Timer1 match FIQ records the interrupted PC
+                    into a hash table of 16-byte address blocks
+
+    Procesor    : Philips LPC2148 MCU with ARM7TDMI-s Core
+
+    Note        : Sampling runs as FIQ so it also sees time spent inside
+                  IRQ handlers. prof_dump() prints plain text; profsym.c
+                  maps the "S" addresses to function names using the
+                  linker map on the host. Timer1 is used exclusively (see
+                  profiler.h).
+
+                [Please refer to LPC2148 MCU user manual, chapter "Timer0/1"]
+ ----------------------------------------------------------------------------*/
+
+#include "NXP/iolpc2124.h"
+#include "inr.h"
+#include "profiler.h"
+
+#define PROF_PROBES   8         //Open-addressing probe limit
+
+prof_region  prof_regions[PROF_SLOTS];
+prof_bucket  prof_buckets[PROF_BUCKETS];
+unsigned int prof_dropped;
+
+/*-------------------------------------------------------------------------
+   Function Name: prof_isr
+
+   Parameters: None
+ 
+   Return:  None
+ 
+   Description: Timer1 MR0 FIQ. Re-arms the match one period ahead (the
+                counter keeps running for the markers) and counts a hit
+                for the block holding the interrupted PC. If the FIQ was
+                held off for a whole period the next match would already
+                be behind the counter and only come round after a 2^32
+                tick wrap, so it is then re-armed from the counter.
+ ---------------------------------------------------------------------------*/
+static void prof_isr(void)
+{
+  unsigned int block = fiq_return_pc >> PROF_PC_SHIFT;
+  unsigned int h;
+
+  T1IR  = 1;                               //Clear MR0 interrupt flag
+  T1MR0 += PROF_SAMPLE_TICKS;
+  if((int)(T1MR0 - T1TC) <= 0)
+    T1MR0 = T1TC + PROF_SAMPLE_TICKS;      //Missed a period
+
+  h = (block * 2654435761u) >> (32 - PROF_BUCKET_BITS);   //Fibonacci hash
+  for(int i = 0; i < PROF_PROBES; i++)
+  {
+    prof_bucket *b = &prof_buckets[(h + i) & (PROF_BUCKETS - 1)];
+
+    if(b->block == block)
+    {
+      b->hits++;
+      return;
+    }
+    if(b->hits == 0)                       //Free (block 0 is a valid address)
+    {
+      b->block = block;
+      b->hits  = 1;
+      return;
+    }
+  }
+  prof_dropped++;
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: prof_init
+
+   Parameters: None
+ 
+   Return:  None
+ 
+   Description: Starts Timer1 counting PCLK and installs the sampling FIQ
+                (left disabled until prof_sampling(1))
+ ---------------------------------------------------------------------------*/
+void prof_init(void)
+{
+  T1TCR = 2;                      //Reset and hold Timer1
+  T1PR  = 0;                      //One count per PCLK
+  T1MCR = 0;                      //No match action yet
+  T1IR  = 0xFF;
+  T1TCR = 1;                      //Run
+
+  prof_reset();
+  install_FIQ(PROF_INT_NUMBER, prof_isr);
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: prof_sampling
+
+   Parameters: 1 to start PC sampling, 0 to stop
+ 
+   Return:  None
+ 
+   Description: Enables or disables the MR0 match interrupt
+ ---------------------------------------------------------------------------*/
+void prof_sampling(int on)
+{
+  if(on)
+  {
+    T1MR0 = T1TC + PROF_SAMPLE_TICKS;
+    T1IR  = 1;
+    T1MCR = 1;                    //Interrupt on MR0, no reset
+  }
+  else
+  {
+    T1MCR = 0;
+  }
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: prof_reset
+
+   Parameters: None
+ 
+   Return:  None
+ 
+   Description: Clears both tables
+ ---------------------------------------------------------------------------*/
+void prof_reset(void)
+{
+  for(int i = 0; i < PROF_SLOTS; i++)
+  {
+    prof_regions[i].count = 0;
+    prof_regions[i].total = 0;
+    prof_regions[i].max   = 0;
+  }
+  for(int i = 0; i < PROF_BUCKETS; i++)
+  {
+    prof_buckets[i].block = 0;
+    prof_buckets[i].hits  = 0;
+  }
+  prof_dropped = 0;
+}
+
+//Writes "0x" and eight hex digits
+static char *prof_hex(char *p, unsigned int v)
+{
+  *p++ = '0';
+  *p++ = 'x';
+  for(int s = 28; s >= 0; s -= 4)
+  {
+    *p++ = "0123456789ABCDEF"[(v >> s) & 0xF];
+  }
+  return p;
+}
+
+//Writes " " and a decimal number
+static char *prof_dec(char *p, unsigned int v)
+{
+  char tmp[10];
+  int n = 0;
+
+  do
+  {
+    tmp[n++] = '0' + v % 10;
+    v /= 10;
+  } while(v);
+
+  *p++ = ' ';
+  while(n)
+    *p++ = tmp[--n];
+  return p;
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: prof_dump
+
+   Parameters: Line output function (UART, semihosting, ...)
+ 
+   Return:  None
+ 
+   Description: Emits one text line per used entry:
+                  R <id> <count> <total ticks> <max ticks>
+                  S <block address> <hits>
+                  D <dropped samples>
+ ---------------------------------------------------------------------------*/
+void prof_dump(void (*put)(const char *line))
+{
+  char line[48];
+  char *p;
+
+  for(int i = 0; i < PROF_SLOTS; i++)
+  {
+    if(prof_regions[i].count == 0)
+      continue;
+    p = line;
+    *p++ = 'R';
+    p = prof_dec(p, i);
+    p = prof_dec(p, prof_regions[i].count);
+    p = prof_dec(p, prof_regions[i].total);
+    p = prof_dec(p, prof_regions[i].max);
+    *p = '\0';
+    put(line);
+  }
+
+  for(int i = 0; i < PROF_BUCKETS; i++)
+  {
+    if(prof_buckets[i].hits == 0)
+      continue;
+    p = line;
+    *p++ = 'S';
+    *p++ = ' ';
+    p = prof_hex(p, prof_buckets[i].block << PROF_PC_SHIFT);
+    p = prof_dec(p, prof_buckets[i].hits);
+    *p = '\0';
+    put(line);
+  }
+
+  p = line;
+  *p++ = 'D';
+  p = prof_dec(p, prof_dropped);
+  *p = '\0';
+  put(line);
+}
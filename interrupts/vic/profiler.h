@@ -0,0 +1,85 @@
+/*--------------------------------------------------------------
+ File:      profiler.h
+ Purpose:   Cycle profiler (instrumented markers and PC sampling)
+ Compiler:  IAR EW 5.5
+ System:    Philips LPC2148 MCU with ARM7TDMI-s core
+----------------------------------------------------------------*/
+
+//If this file is not included by another program, define it here (avoids multiple definitions)
+#ifndef   __PROFILER_H
+#define   __PROFILER_H
+
+#include "NXP/iolpc2124.h"
+
+/*
+   The profiler owns Timer1 (TC as the time base, MR0 for sampling):
+   prof_init() resets it and prof_enter()/prof_exit() read T1TC directly.
+   Do not link it with other Timer1 users in this repository, i.e.
+   lcd_bench.c (resets T1TC) and adcblock.c (T1 match resets TC and
+   drives the ADC start).
+*/
+
+//Macros
+#define PROF_INT_NUMBER    5        //Timer1 interrupt source
+#define PROF_SAMPLE_TICKS  3001     //PCLK ticks between PC samples (~1 ms, odd to avoid aliasing)
+#define PROF_SLOTS         16       //Instrumented regions (ids 0..PROF_SLOTS-1)
+#define PROF_BUCKET_BITS   7
+#define PROF_BUCKETS       (1 << PROF_BUCKET_BITS)   //PC sample table entries
+#define PROF_PC_SHIFT      4        //Sample granularity: 16-byte address blocks
+
+//Instrumented region statistics (Timer1 PCLK ticks)
+typedef struct
+{
+  unsigned int start;     //TC at the last prof_enter()
+  unsigned int count;     //Completed enter/exit pairs
+  unsigned int total;     //Sum of durations
+  unsigned int max;       //Longest duration
+} prof_region;
+
+//PC sample bucket
+typedef struct
+{
+  unsigned int block;     //PC >> PROF_PC_SHIFT
+  unsigned int hits;      //0 = free
+} prof_bucket;
+
+extern prof_region prof_regions[PROF_SLOTS];
+extern prof_bucket prof_buckets[PROF_BUCKETS];
+extern unsigned int prof_dropped;   //Samples lost to a full table
+
+//Function Prototypes
+void prof_init(void);
+
+void prof_sampling(int on);
+
+void prof_reset(void);
+
+void prof_dump(void (*put)(const char *line));
+
+/*-------------------------------------------------------------------------
+   Function Name: prof_enter / prof_exit
+
+   Parameters: Region id (0..PROF_SLOTS-1)
+ 
+   Return:  None
+ 
+   Description: Markers around a region, inline so the cost is one
+                timer read each. Regions may nest but not recurse.
+ ---------------------------------------------------------------------------*/
+static inline void prof_enter(int id)
+{
+  prof_regions[id].start = T1TC;
+}
+
+static inline void prof_exit(int id)
+{
+  prof_region *r = &prof_regions[id];
+  unsigned int d = T1TC - r->start;
+
+  r->count++;
+  r->total += d;
+  if(d > r->max)
+    r->max = d;
+}
+
+#endif //__PROFILER_H
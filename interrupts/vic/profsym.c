@@ -0,0 +1,240 @@
+/*----------------------------------------------------------------------------
+    File name   : profsym.c
+
+    Description : host tool for profiler.c. Reads the prof_dump() text
+                  and the IAR linker map of the same build, turns the
+                  "S" sample blocks into function names and prints the
+                  hits per function, most sampled first. "R" and "D"
+                  lines are passed through.
+
+    Procesor    : host PC
+
+    Note        : Build from interrupts/vic, run with the .map of the
+                  profiled image (Linker > List > Generate linker map file):
+
+      cc -O2 profsym.c -o profsym
+      ./profsym Debug/List/interrupt.map dump.txt
+      ./profsym Debug/List/interrupt.map < dump.txt
+
+                  Only the ENTRY LIST of the map is used. Thumb entries
+                  have bit 0 set; it is masked off. A sample block is
+                  credited to the function holding its first byte (or its
+                  last byte if the first lies in a gap), so a few hits can
+                  land on the previous function when one starts inside a
+                  block. BLOCK_BYTES must match PROF_PC_SHIFT.
+ ----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOCK_BYTES 16      //1 << PROF_PC_SHIFT
+#define MAX_SYMS    8192
+#define NAME_LEN    128
+
+typedef struct
+{
+  char          name[NAME_LEN];
+  unsigned long addr;
+  unsigned long size;     //0 = not given, extends to the next symbol
+  unsigned long hits;
+} sym;
+
+static sym syms[MAX_SYMS];
+static int nsyms;
+
+static int by_addr(const void *a, const void *b)
+{
+  const sym *x = a;
+  const sym *y = b;
+
+  return x->addr < y->addr ? -1 : x->addr > y->addr;
+}
+
+static int by_hits(const void *a, const void *b)
+{
+  const sym *x = a;
+  const sym *y = b;
+
+  return x->hits > y->hits ? -1 : x->hits < y->hits;
+}
+
+//Parses "0x...." (returns 0 if the token is no hex number)
+static int hex_token(const char *t, unsigned long *v)
+{
+  char *end;
+
+  if(t == NULL || t[0] != '0' || (t[1] != 'x' && t[1] != 'X'))
+    return 0;
+  *v = strtoul(t, &end, 16);
+  return *end == '\0';
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: load_map
+
+   Parameters: Map file name
+
+   Return:  Number of code symbols read, -1 if the file cannot be opened
+
+   Description: Reads the ENTRY LIST. An entry is
+                  name  0xaddr  [0xsize]  Code|Data  ...
+                and a name too long for its column stands alone on one
+                line with the rest on the next.
+ ---------------------------------------------------------------------------*/
+static int load_map(const char *file)
+{
+  FILE *f = fopen(file, "r");
+  char  line[512];
+  char  pending[NAME_LEN] = "";
+  int   in_list = 0;
+
+  if(f == NULL)
+    return -1;
+
+  while(fgets(line, sizeof line, f))
+  {
+    char *tok[4] = { NULL, NULL, NULL, NULL };
+    int   n = 0;
+    int   t = 0;
+    unsigned long addr;
+    unsigned long size = 0;
+
+    if(strstr(line, "*** ENTRY LIST"))
+    {
+      in_list = 1;
+      continue;
+    }
+    if(!in_list)
+      continue;
+
+    for(char *p = strtok(line, " \t\r\n"); p && n < 4; p = strtok(NULL, " \t\r\n"))
+      tok[n++] = p;
+    if(n == 0)
+      continue;
+
+    if(n == 1)                                 //Wrapped name
+    {
+      strncpy(pending, tok[0], NAME_LEN - 1);
+      pending[NAME_LEN - 1] = '\0';
+      continue;
+    }
+
+    if(hex_token(tok[0], &addr) && pending[0])
+      t = 1;                                   //Continuation of a wrapped name
+    else if(hex_token(tok[1], &addr))
+    {
+      strncpy(pending, tok[0], NAME_LEN - 1);
+      pending[NAME_LEN - 1] = '\0';
+      t = 2;
+    }
+    else
+    {
+      pending[0] = '\0';
+      continue;
+    }
+
+    if(t < n && hex_token(tok[t], &size))
+      t++;
+    if(t < n && strcmp(tok[t], "Code") == 0 && nsyms < MAX_SYMS)
+    {
+      strcpy(syms[nsyms].name, pending);
+      syms[nsyms].addr = addr & ~1UL;          //Thumb bit
+      syms[nsyms].size = size;
+      syms[nsyms].hits = 0;
+      nsyms++;
+    }
+    pending[0] = '\0';
+  }
+  fclose(f);
+
+  qsort(syms, nsyms, sizeof(sym), by_addr);
+  return nsyms;
+}
+
+//Function holding an address, NULL if none
+static sym *lookup(unsigned long a)
+{
+  int lo = 0;
+  int hi = nsyms - 1;
+  sym *s;
+
+  if(nsyms == 0 || a < syms[0].addr)
+    return NULL;
+  while(lo < hi)                               //Last symbol with addr <= a
+  {
+    int mid = (lo + hi + 1) / 2;
+
+    if(syms[mid].addr <= a)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+  s = &syms[lo];
+  if(s->size && a >= s->addr + s->size)
+    return NULL;
+  return s;
+}
+
+int main(int argc, char *argv[])
+{
+  FILE *in = stdin;
+  char  line[128];
+  unsigned long total = 0;
+  unsigned long unknown = 0;
+
+  if(argc < 2)
+  {
+    fprintf(stderr, "usage: %s <image.map> [prof_dump.txt]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  if(load_map(argv[1]) <= 0)
+  {
+    fprintf(stderr, "%s: no code entries found\n", argv[1]);
+    return EXIT_FAILURE;
+  }
+  if(argc > 2 && (in = fopen(argv[2], "r")) == NULL)
+  {
+    perror(argv[2]);
+    return EXIT_FAILURE;
+  }
+
+  while(fgets(line, sizeof line, in))
+  {
+    unsigned long block;
+    unsigned long hits;
+
+    if(sscanf(line, "S %lx %lu", &block, &hits) == 2)
+    {
+      sym *s = lookup(block);
+
+      if(s == NULL)
+        s = lookup(block + BLOCK_BYTES - 1);
+
+      if(s)
+        s->hits += hits;
+      else
+        unknown += hits;
+      total += hits;
+    }
+    else if(line[0] == 'R' || line[0] == 'D')
+      fputs(line, stdout);
+  }
+  if(in != stdin)
+    fclose(in);
+
+  if(total == 0)
+  {
+    printf("no samples\n");
+    return EXIT_SUCCESS;
+  }
+
+  qsort(syms, nsyms, sizeof(sym), by_hits);
+  printf("%10s %7s  %s\n", "hits", "%", "function");
+  for(int i = 0; i < nsyms && syms[i].hits; i++)
+    printf("%10lu %6.2f%%  %s\n", syms[i].hits, 100.0 * syms[i].hits / total, syms[i].name);
+  if(unknown)
+    printf("%10lu %6.2f%%  (outside any code entry)\n", unknown, 100.0 * unknown / total);
+  printf("%10lu samples\n", total);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,189 @@
+/*----------------------------------------------------------------------------
+    File name   : stackmon.c
+
+    Description : paints the mode stacks and the heap at startup and reports
+                  how much of each was ever used
+
+    Procesor    : Philips LPC2148 MCU with ARM7TDMI-s Core
+
+    Note        : Region bounds come from the linker (__section_begin/end
+                  of the .icf blocks), so the report always matches the
+                  sizes in the linker map. Stacks grow down, so the used
+                  part is everything above the lowest overwritten word;
+                  the heap grows up, so its used part is everything below
+                  the highest overwritten word.
+
+                  Painting runs from __low_level_init(), before cstartup
+                  initializes .data/.bss and before main(). Define
+                  STACKMON_NO_LOW_LEVEL_INIT if the project already has its
+                  own __low_level_init and call stackmon_paint() from it.
+ ----------------------------------------------------------------------------*/
+
+#include "stackmon.h"
+
+#pragma section = "CSTACK"
+#pragma section = "SVC_STACK"
+#pragma section = "IRQ_STACK"
+#pragma section = "FIQ_STACK"
+#pragma section = "HEAP"
+
+static const char * const stk_names[STK_REGIONS] =
+{
+  "CSTACK", "SVC_STACK", "IRQ_STACK", "FIQ_STACK", "HEAP"
+};
+
+/*-------------------------------------------------------------------------
+   Function Name: stk_bounds
+
+   Parameters: Region number, pointers receiving first and end word
+ 
+   Return:  None
+ 
+   Description: Linker bounds of a region (end is exclusive)
+ ---------------------------------------------------------------------------*/
+static void stk_bounds(int region, unsigned int **lo, unsigned int **hi)
+{
+  switch(region)
+  {
+  case STK_USR_SYS:
+    *lo = __section_begin("CSTACK");    *hi = __section_end("CSTACK");    break;
+  case STK_SVC:
+    *lo = __section_begin("SVC_STACK"); *hi = __section_end("SVC_STACK"); break;
+  case STK_IRQ:
+    *lo = __section_begin("IRQ_STACK"); *hi = __section_end("IRQ_STACK"); break;
+  case STK_FIQ:
+    *lo = __section_begin("FIQ_STACK"); *hi = __section_end("FIQ_STACK"); break;
+  default:
+    *lo = __section_begin("HEAP");      *hi = __section_end("HEAP");      break;
+  }
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: stackmon_paint
+
+   Parameters: None
+ 
+   Return:  None
+ 
+   Description: Fills every region with STACKMON_PAINT. The region holding
+                the current stack pointer is only painted up to
+                STACKMON_MARGIN words below it. Uses no static data.
+ ---------------------------------------------------------------------------*/
+void stackmon_paint(void)
+{
+  volatile unsigned int marker;               //Lives at the current SP
+  unsigned int *sp = (unsigned int *)&marker;
+
+  for(int r = 0; r < STK_REGIONS; r++)
+  {
+    unsigned int *lo;
+    unsigned int *hi;
+
+    stk_bounds(r, &lo, &hi);
+    if(sp >= lo && sp < hi)
+      hi = sp - STACKMON_MARGIN;
+
+    while(lo < hi)
+      *lo++ = STACKMON_PAINT;
+  }
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: stackmon_high_water
+
+   Parameters: Region number (STK_xxx)
+ 
+   Return:  Peak bytes used in the region
+ 
+   Description: Stacks: counts painted words from the bottom up; the
+                first word that no longer holds the pattern marks the
+                deepest use. Heap: the same from the top down, since the
+                allocator hands out blocks from the bottom.
+ ---------------------------------------------------------------------------*/
+unsigned int stackmon_high_water(int region)
+{
+  unsigned int *lo;
+  unsigned int *hi;
+  unsigned int *p;
+
+  stk_bounds(region, &lo, &hi);
+  if(region == STK_HEAP)
+  {
+    for(p = hi; p > lo && p[-1] == STACKMON_PAINT; p--)
+    {
+    }
+    return (unsigned int)(p - lo) * sizeof(unsigned int);
+  }
+
+  for(p = lo; p < hi && *p == STACKMON_PAINT; p++)
+  {
+  }
+  return (unsigned int)(hi - p) * sizeof(unsigned int);
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: stackmon_free_ram
+
+   Parameters: None
+ 
+   Return:  Bytes never touched across all monitored regions
+ 
+   Description: Stack headroom plus untouched heap, i.e. how much RAM the
+                linker blocks could give back to buffers
+ ---------------------------------------------------------------------------*/
+unsigned int stackmon_free_ram(void)
+{
+  unsigned int unused = 0;
+
+  for(int r = 0; r < STK_REGIONS; r++)
+  {
+    unsigned int *lo;
+    unsigned int *hi;
+
+    stk_bounds(r, &lo, &hi);
+    unused += (unsigned int)(hi - lo) * sizeof(unsigned int) - stackmon_high_water(r);
+  }
+  return unused;
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: stackmon_report
+
+   Parameters: Array of STK_REGIONS entries to fill
+ 
+   Return:  None
+ 
+   Description: Name, placement, linker size and high-water mark of every
+                region, ready to print or inspect in the Watch window
+ ---------------------------------------------------------------------------*/
+void stackmon_report(stackmon_info *info)
+{
+  for(int r = 0; r < STK_REGIONS; r++)
+  {
+    unsigned int *lo;
+    unsigned int *hi;
+
+    stk_bounds(r, &lo, &hi);
+    info[r].name = stk_names[r];
+    info[r].base = (unsigned int)lo;
+    info[r].size = (unsigned int)(hi - lo) * sizeof(unsigned int);
+    info[r].used = stackmon_high_water(r);
+  }
+}
+
+#ifndef STACKMON_NO_LOW_LEVEL_INIT
+/*-------------------------------------------------------------------------
+   Function Name: __low_level_init
+
+   Parameters: None
+ 
+   Return:  1 = let cstartup initialize the data segments
+ 
+   Description: Called by IAR cstartup once the mode stacks are set up
+ ---------------------------------------------------------------------------*/
+__interwork int __low_level_init(void)
+{
+  stackmon_paint();
+  return 1;
+}
+#endif
@@ -0,0 +1,42 @@
+/*--------------------------------------------------------------
+ File:      stackmon.h
+ Purpose:   Stack painting and RAM high-water marks per CPU mode
+ Compiler:  IAR EW 5.5
+ System:    Philips LPC2148 MCU with ARM7TDMI-s core
+----------------------------------------------------------------*/
+
+//If this file is not included by another program, define it here (avoids multiple definitions)
+#ifndef   __STACKMON_H
+#define   __STACKMON_H
+
+//Macros
+#define STACKMON_PAINT   0xCDCDCDCD   //Fill pattern for unused RAM
+#define STACKMON_MARGIN  16           //Words left unpainted below the live SP
+
+//Monitored regions (linker blocks of the IAR .icf file)
+#define STK_USR_SYS   0   //CSTACK    - User/System mode, main()
+#define STK_SVC       1   //SVC_STACK - Supervisor mode
+#define STK_IRQ       2   //IRQ_STACK - IRQ_Handler and vectored ISRs
+#define STK_FIQ       3   //FIQ_STACK - FIQ_Handler
+#define STK_HEAP      4   //HEAP      - grows up; used = bytes from the bottom
+#define STK_REGIONS   5
+
+//One line of the report
+typedef struct
+{
+  const char  *name;      //Linker block name, as in the .map file
+  unsigned int base;      //Lowest address
+  unsigned int size;      //Bytes reserved by the linker
+  unsigned int used;      //Bytes ever written (high-water mark; heap from base)
+} stackmon_info;
+
+//Function Prototypes
+void stackmon_paint(void);
+
+unsigned int stackmon_high_water(int region);
+
+unsigned int stackmon_free_ram(void);
+
+void stackmon_report(stackmon_info *info);
+
+#endif //__STACKMON_H
@@ -0,0 +1,301 @@
+/*----------------------------------------------------------------------------
+    File name   : swtimer.c
+
+    Description : software timer service. Any number of one-shot and
+                  periodic timers share Timer0 through a hierarchical timing
+                  wheel; start and stop are O(1).
+
+    Procesor    : Philips LPC2148 MCU with ARM7TDMI-s Core
+
+    Note        : Timer0 runs free at SWT_TICK_HZ and is never reset. MR0
+                  is moved to the next non-empty level-0 slot (or the next
+                  cascade point, at most SWT_SLOTS ticks away), so there is
+                  no periodic tick interrupt while nothing is due.
+
+                  Callbacks run in IRQ context; they may start or stop
+                  timers (including their own) but must not block.
+
+                  swtimer_host.c runs this file on the PC against a
+                  simulated Timer0 (start race, catch-up after interrupts
+                  were off, counter wrap).
+
+                [Please refer to LPC2148 MCU user manual, chapter "Timer0/1"]
+ ----------------------------------------------------------------------------*/
+
+#include "NXP/iolpc2124.h"
+#include "inr.h"
+#include "swtimer.h"
+
+#define SWT_MASK   (SWT_SLOTS - 1)
+
+static swtimer     *wheel[SWT_LEVELS][SWT_SLOTS];   //Slot list heads
+static unsigned int swt_now;                        //Last tick processed
+
+//Some local function definitions
+static void swt_isr(void);
+
+/*-------------------------------------------------------------------------
+   Function Name: swt_link / swt_unlink
+
+   Parameters: Timer
+ 
+   Return:  None
+ 
+   Description: Inserts a timer into the slot its expiry falls in, or
+                removes it from whatever slot it is in. Both are O(1).
+ ---------------------------------------------------------------------------*/
+static void swt_link(swtimer *t)
+{
+  unsigned int delta = t->expires - swt_now;
+  swtimer **head;
+
+  if(delta < SWT_SLOTS)
+    head = &wheel[0][t->expires & SWT_MASK];
+  else if(delta < (1UL << (2 * SWT_BITS)))
+    head = &wheel[1][(t->expires >> SWT_BITS) & SWT_MASK];
+  else
+    head = &wheel[2][(t->expires >> (2 * SWT_BITS)) & SWT_MASK];
+
+  t->next = *head;
+  if(t->next)
+    t->next->pprev = &t->next;
+  t->pprev = head;
+  *head = t;
+}
+
+static void swt_unlink(swtimer *t)
+{
+  *t->pprev = t->next;
+  if(t->next)
+    t->next->pprev = t->pprev;
+  t->next = 0;
+  t->pprev = 0;
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: swt_cascade
+
+   Parameters: Wheel level and slot index
+ 
+   Return:  None
+ 
+   Description: Re-files every timer of a coarse slot against the current
+                time; they land in finer levels as they get closer
+ ---------------------------------------------------------------------------*/
+static void swt_cascade(int level, unsigned int idx)
+{
+  swtimer *t = wheel[level][idx];
+
+  wheel[level][idx] = 0;
+  while(t)
+  {
+    swtimer *next = t->next;
+    swt_link(t);
+    t = next;
+  }
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: swt_tick
+
+   Parameters: None
+ 
+   Return:  None
+ 
+   Description: Advances the wheel by one tick and fires the timers due
+ ---------------------------------------------------------------------------*/
+static void swt_tick(void)
+{
+  unsigned int idx;
+  swtimer *t;
+
+  swt_now++;
+  idx = swt_now & SWT_MASK;
+
+  if(idx == 0)
+  {
+    unsigned int idx1 = (swt_now >> SWT_BITS) & SWT_MASK;
+
+    swt_cascade(1, idx1);
+    if(idx1 == 0)
+      swt_cascade(2, (swt_now >> (2 * SWT_BITS)) & SWT_MASK);
+  }
+
+  while((t = wheel[0][idx]) != 0)
+  {
+    swt_unlink(t);
+    if(t->period)                 //Re-arm first so the callback may stop it
+    {
+      t->expires += t->period;
+      swt_link(t);
+    }
+    t->callback(t);
+  }
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: swt_next_match
+
+   Parameters: None
+ 
+   Return:  Absolute tick of the next interrupt
+ 
+   Description: Nearest non-empty level-0 slot, or the next cascade point
+ ---------------------------------------------------------------------------*/
+static unsigned int swt_next_match(void)
+{
+  unsigned int d;
+  unsigned int limit = SWT_SLOTS - (swt_now & SWT_MASK);
+
+  for(d = 1; d < limit; d++)
+  {
+    if(wheel[0][(swt_now + d) & SWT_MASK])
+      break;
+  }
+  return swt_now + d;
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: swt_isr
+
+   Parameters: None
+ 
+   Return:  None
+ 
+   Description: Timer0 MR0 interrupt. Catches the wheel up with the
+                counter, then programs MR0 for the next deadline; loops if
+                that deadline already passed while callbacks were running.
+ ---------------------------------------------------------------------------*/
+static void swt_isr(void)
+{
+  unsigned int match;
+
+  T0IR = 1;                       //Clear MR0 interrupt flag
+  VICSoftIntClear = 1 << SWT_INT_NUMBER;  //And a request from swtimer_start
+
+  do
+  {
+    unsigned int target = T0TC;
+
+    while(swt_now != target)
+      swt_tick();
+
+    match = swt_next_match();
+    T0MR0 = match;
+  } while((int)(match - T0TC) <= 0);
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: swtimer_init
+
+   Parameters: None
+ 
+   Return:  None
+ 
+   Description: Starts Timer0 as a free-running tick counter and installs
+                the MR0 interrupt. VIC_init() must have been called.
+ ---------------------------------------------------------------------------*/
+void swtimer_init(void)
+{
+  T0TCR = 2;                              //Reset and hold Timer0
+  T0PR  = SWT_PCLK_HZ / SWT_TICK_HZ - 1;  //One count per tick
+  T0MCR = 1;                              //Interrupt on MR0, no reset/stop
+  T0IR  = 0xFF;                           //Clear pending flags
+  swt_now = 0;
+  T0MR0 = SWT_SLOTS;
+
+  install_IRQ(SWT_INT_NUMBER, swt_isr, SWT_VIC_SLOT);
+
+  T0TCR = 1;                              //Run
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: swtimer_setup
+
+   Parameters: Timer and callback
+ 
+   Return:  None
+ 
+   Description: Prepares an idle timer; call once before swtimer_start()
+ ---------------------------------------------------------------------------*/
+void swtimer_setup(swtimer *t, void (*callback)(swtimer *))
+{
+  t->next     = 0;
+  t->pprev    = 0;
+  t->expires  = 0;
+  t->period   = 0;
+  t->callback = callback;
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: swtimer_start
+
+   Parameters: Timer, ticks to first expiry and reload period (0 = one-shot)
+ 
+   Return:  None
+ 
+   Description: (Re)starts a timer. Delay is clamped to 1..SWT_MAX_DELAY.
+                Pulls MR0 in if the new timer is due before the current
+                match; if the counter already reached the new deadline the
+                match would be missed, so the interrupt is raised in
+                software instead. Safe to call from main code and from
+                callbacks.
+ ---------------------------------------------------------------------------*/
+void swtimer_start(swtimer *t, unsigned int delay, unsigned int period)
+{
+  __istate_t state = __get_interrupt_state();
+
+  if(delay == 0)
+    delay = 1;
+  if(delay > SWT_MAX_DELAY)
+    delay = SWT_MAX_DELAY;
+  if(period > SWT_MAX_DELAY)
+    period = SWT_MAX_DELAY;
+
+  __disable_interrupt();
+
+  if(t->pprev)
+    swt_unlink(t);
+
+  t->expires = T0TC + delay;
+  t->period  = period;
+  swt_link(t);
+
+  if((int)(t->expires - T0MR0) < 0)
+  {
+    T0MR0 = t->expires;
+    if((int)(t->expires - T0TC) <= 0)
+      VICSoftInt = 1 << SWT_INT_NUMBER;
+  }
+
+  __set_interrupt_state(state);
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: swtimer_stop
+
+   Parameters: Timer
+ 
+   Return:  None
+ 
+   Description: Cancels a pending timer; no effect on an idle one
+ ---------------------------------------------------------------------------*/
+void swtimer_stop(swtimer *t)
+{
+  __istate_t state = __get_interrupt_state();
+
+  __disable_interrupt();
+  if(t->pprev)
+    swt_unlink(t);
+  __set_interrupt_state(state);
+}
+
+int swtimer_pending(const swtimer *t)
+{
+  return t->pprev != 0;
+}
+
+unsigned int swtimer_now(void)
+{
+  return T0TC;
+}
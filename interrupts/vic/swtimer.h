@@ -0,0 +1,48 @@
+/*--------------------------------------------------------------
+ File:      swtimer.h
+ Purpose:   Software timers multiplexed on Timer0 (timing wheel)
+ Compiler:  IAR EW 5.5
+ System:    Philips LPC2148 MCU with ARM7TDMI-s core
+----------------------------------------------------------------*/
+
+//If this file is not included by another program, define it here (avoids multiple definitions)
+#ifndef   __SWTIMER_H
+#define   __SWTIMER_H
+
+#include "../../hal/board.h"
+
+//Macros
+#define SWT_PCLK_HZ     BOARD_PCLK_HZ
+#define SWT_TICK_HZ     1000      //1 ms ticks
+#define SWT_INT_NUMBER  4         //Timer0 interrupt source
+#define SWT_VIC_SLOT    1         //Vectored IRQ slot (lower = higher priority)
+
+#define SWT_BITS        6         //64 slots per wheel level
+#define SWT_LEVELS      3         //1, 64 and 4096 ticks per slot
+#define SWT_SLOTS       (1 << SWT_BITS)
+#define SWT_MAX_DELAY   ((1UL << (SWT_BITS * SWT_LEVELS)) - 1 - SWT_SLOTS)  //~262 s
+
+//Timer object, owned by the caller (no allocation, any number of timers)
+typedef struct swtimer
+{
+  struct swtimer  *next;
+  struct swtimer **pprev;                //Link to this entry, 0 when idle
+  unsigned int     expires;              //Absolute tick
+  unsigned int     period;               //Reload in ticks, 0 = one-shot
+  void           (*callback)(struct swtimer *);
+} swtimer;
+
+//Function Prototypes
+void swtimer_init(void);
+
+void swtimer_setup(swtimer *t, void (*callback)(swtimer *));
+
+void swtimer_start(swtimer *t, unsigned int delay, unsigned int period);
+
+void swtimer_stop(swtimer *t);
+
+int swtimer_pending(const swtimer *t);
+
+unsigned int swtimer_now(void);
+
+#endif //__SWTIMER_H
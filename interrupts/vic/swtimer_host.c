@@ -0,0 +1,204 @@
+/*----------------------------------------------------------------------------
+    File name   : swtimer_host.c
+
+    Description : host check for swtimer.c. Timer0 is a plain counter
+                  stepped one tick at a time; the MR0 flag latches when the
+                  counter equals the match register, as on the chip, and
+                  the ISR runs whenever the flag or the VICSoftInt request
+                  is set. Thousands of one-shot and periodic timers are
+                  started, restarted from their callbacks and stopped at
+                  random, across a wrap of the 32-bit counter. The run also
+                  covers
+                    - the start race: the counter moves on between the
+                      read in swtimer_start() and the MR0 update, so the
+                      new deadline is already reached (VICSoftInt path)
+                    - catch-up: interrupts stay off for 65..300 ticks, the
+                      match passes unseen and the ISR must then replay
+                      every tick of the gap
+                  Each callback must run at its own tick of the wheel and,
+                  outside the catch-up windows, at that counter value; no
+                  pending timer may be overdue once the ISR has run.
+
+    Procesor    : host PC
+
+    Note        : Build and run from interrupts/vic:
+
+      cc -I../../lcd/hd44780-model/host swtimer_host.c -o swtimer_host
+      ./swtimer_host
+ ----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TIMERS      3000
+#define STEPS       2000000L   //Counter ticks simulated
+#define POKE_EVERY  1000       //Main code starts or stops a timer
+#define RACE_EVERY  3000       //Of those, a start that hits the race
+#define OFF_EVERY   7919       //Interrupts off for 65..300 ticks
+
+volatile unsigned long T0TCR, T0PR, T0TC, T0MR0, T0MCR, T0IR;
+volatile unsigned long VICSoftInt, VICSoftIntClear;
+
+static void (*isr)(void);
+
+void install_IRQ(unsigned int IntNumber, void (*ISR)(void), unsigned int channel)
+{
+  (void)IntNumber;
+  (void)channel;
+  isr = ISR;
+}
+
+static int           mr0_flag;  //MR0 interrupt flag
+static int           race;      //Next T0TC read lets the counter move on
+static unsigned long tc_race;
+
+//One counter tick; the match flag latches on equality only
+static void tc_step(void)
+{
+  T0TC = (unsigned int)(T0TC + 1);
+  if(T0TC == T0MR0)
+    mr0_flag = 1;
+}
+
+static unsigned long tc_read_race(void)
+{
+  unsigned long v = T0TC;
+
+  race = 0;
+  tc_step();
+  return v;
+}
+
+//swtimer.c sees the counter through this while a race is armed
+#define T0TC  (*(race ? (tc_race = tc_read_race(), &tc_race) : &T0TC))
+#include "swtimer.c"
+#undef T0TC
+
+static swtimer      tm[TIMERS];
+static unsigned int due[TIMERS];
+static int          catching_up;
+static long         fired, wrong_tick, late, overdue, irqs, soft, catchups;
+
+static unsigned int rand_delay(unsigned int max)
+{
+  unsigned int d = 1 + rand() % max;
+
+  return d > SWT_MAX_DELAY ? SWT_MAX_DELAY : d;
+}
+
+static void callback(swtimer *t)
+{
+  int i = t - tm;
+
+  fired++;
+  if(swt_now != due[i])
+  {
+    if(wrong_tick++ < 5)
+      printf("timer %d due %u fired at wheel tick %u\n", i, due[i], swt_now);
+  }
+  else if(!catching_up && (unsigned int)T0TC != due[i])
+    late++;
+
+  if(t->period)
+    due[i] += t->period;
+  else if(rand() % 2)
+  {
+    unsigned int d = rand_delay(300000);
+
+    due[i] = (unsigned int)T0TC + d;
+    swtimer_start(t, d, 0);
+  }
+}
+
+//Runs the ISR if the match flag or the software request is set
+static void service(void)
+{
+  if(!mr0_flag && !(VICSoftInt & (1 << SWT_INT_NUMBER)))
+    return;
+  irqs++;
+  if(VICSoftInt & (1 << SWT_INT_NUMBER))
+    soft++;
+  mr0_flag = 0;
+  VICSoftIntClear = 0;
+  isr();
+  VICSoftInt &= ~VICSoftIntClear;
+}
+
+//No pending timer may be behind the counter
+static void check_overdue(long step)
+{
+  for(int i = 0; i < TIMERS; i++)
+  {
+    if(swtimer_pending(&tm[i]) && (int)(due[i] - (unsigned int)T0TC) < 0)
+    {
+      if(overdue++ < 5)
+        printf("step %ld: timer %d due %u still pending at %lu\n", step, i, due[i], T0TC);
+    }
+  }
+}
+
+int main(void)
+{
+  swtimer_init();
+
+  //Start just below the 32-bit wrap
+  T0TC    = 0xFFFF0000UL;
+  swt_now = T0TC;
+  T0MR0   = T0TC + SWT_SLOTS;
+
+  for(int i = 0; i < TIMERS; i++)
+  {
+    unsigned int d = rand_delay(i % 3 == 0 ? 60 : i % 3 == 1 ? 5000 : 400000);
+    unsigned int p = i % 5 == 0 ? 1 + rand() % 7000 : 0;
+
+    swtimer_setup(&tm[i], callback);
+    due[i] = (unsigned int)T0TC + d;
+    swtimer_start(&tm[i], d, p);
+  }
+
+  for(long k = 0; k < STEPS; k++)
+  {
+    tc_step();
+    service();
+
+    if(k % OFF_EVERY == OFF_EVERY - 1)
+    {
+      int off = SWT_SLOTS + 1 + rand() % (300 - SWT_SLOTS);
+
+      for(int n = 0; n < off; n++)
+        tc_step();
+      catchups++;
+      catching_up = 1;
+      service();
+      catching_up = 0;
+      check_overdue(k);
+    }
+
+    if(k % POKE_EVERY == 0)
+    {
+      int i = rand() % TIMERS;
+
+      if(rand() % 2)
+        swtimer_stop(&tm[i]);
+      else if(k % RACE_EVERY == 0)
+      {
+        race = 1;                   //Deadline reached before MR0 is written
+        swtimer_start(&tm[i], 1, tm[i].period);
+        due[i] = (unsigned int)T0TC;
+      }
+      else
+      {
+        unsigned int d = rand_delay(100);
+
+        due[i] = (unsigned int)T0TC + d;
+        swtimer_start(&tm[i], d, tm[i].period);
+      }
+      service();
+    }
+  }
+  check_overdue(STEPS);
+
+  printf("%ld callbacks, %ld IRQs (%ld software), %ld catch-ups\n", fired, irqs, soft, catchups);
+  printf("%ld at the wrong wheel tick, %ld late, %ld overdue\n", wrong_tick, late, overdue);
+  return wrong_tick || late || overdue ? EXIT_FAILURE : EXIT_SUCCESS;
+}
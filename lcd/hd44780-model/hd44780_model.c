@@ -0,0 +1,355 @@
+/*----------------------------------------------------------------------------
+    File name   : hd44780_model.c
+
+    Description : behavioral model of an HD44780 character LCD driven over
+                  GPIO. It is fed the port state after every store with a
+                  timestamp, latches bytes/nibbles on the falling edge of
+                  E, executes them against DDRAM/CGRAM and checks the bus
+                  timing against the datasheet minimums.
+
+    Procesor    : host PC (model of the LCD seen by the LPC21xx boards)
+
+    Note        : Besides the violations, every write is compared with the
+                  moment the controller became ready again; the difference
+                  is time the driver spent waiting for nothing, booked to
+                  the op that made it wait (hd_model_flush() closes the
+                  wait after the last one). Function sets before the first
+                  other instruction are booked as the reset sequence, whose
+                  long waits the datasheet requires.
+                  See lcdsim.c for how the LCD drivers are hooked up.
+ ----------------------------------------------------------------------------*/
+
+#include <string.h>
+#include "hd44780_model.h"
+
+static const char *hd_v_names[HD_V_KINDS] =
+{
+  "power-on delay", "RS/RW setup (tAS)", "E pulse width (PWEH)",
+  "E cycle time (tcycE)", "data setup (tDSW)", "hold (tH)",
+  "write while busy"
+};
+
+static const char *hd_op_names[HD_OP_KINDS] =
+{
+  "data write", "instruction", "clear/home", "reset seq."
+};
+
+/*-------------------------------------------------------------------------
+   Function Name: hd_model_init
+
+   Parameters: Model, port masks of RS, RW (0 if tied low), E and D0-D7
+               (0 for data lines that are not wired)
+ 
+   Return:  None
+ 
+   Description: Power-on state: 8-bit interface, 1 line, display off.
+                Time 0 is the moment Vcc came up.
+ ---------------------------------------------------------------------------*/
+void hd_model_init(hd_model *m, unsigned long rs, unsigned long rw,
+                   unsigned long e, const unsigned long d[8])
+{
+  memset(m, 0, sizeof(*m));
+  m->rs = rs;
+  m->rw = rw;
+  m->e  = e;
+  memcpy(m->d, d, sizeof(m->d));
+  m->bits  = 8;
+  m->inc   = 1;
+  m->lines = 1;
+  m->last_op = -1;
+  memset(m->ddram, ' ', sizeof(m->ddram));
+}
+
+static void hd_violate(hd_model *m, int kind)
+{
+  m->violations[kind]++;
+}
+
+//Byte currently on D0-D7
+static unsigned char hd_bus(const hd_model *m)
+{
+  unsigned char v = 0;
+
+  for(int i = 0; i < 8; i++)
+  {
+    if(m->d[i] && (m->pins & m->d[i]))
+      v |= 1 << i;
+  }
+  return v;
+}
+
+static unsigned long hd_data_mask(const hd_model *m)
+{
+  unsigned long mask = 0;
+
+  for(int i = 0; i < 8; i++)
+    mask |= m->d[i];
+  return mask;
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: hd_book_slack
+
+   Parameters: Model and the time the previous op's wait ended
+ 
+   Return:  None
+ 
+   Description: Books the slack between the controller becoming ready and
+                that time to the previous op, once per op
+ ---------------------------------------------------------------------------*/
+static void hd_book_slack(hd_model *m, unsigned long long t)
+{
+  unsigned long long slack;
+
+  if(m->last_op < 0)
+    return;
+
+  slack = t > m->busy_until ? t - m->busy_until : 0;
+  m->wasted[m->last_op] += slack;
+  if(slack > m->wasted_max[m->last_op])
+    m->wasted_max[m->last_op] = slack;
+  m->booked[m->last_op]++;
+  m->last_op = -1;
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: hd_execute
+
+   Parameters: Model, RS level, complete byte, time of the E falling edge
+ 
+   Return:  None
+ 
+   Description: Runs one instruction or data write and books its wait time
+ ---------------------------------------------------------------------------*/
+static void hd_execute(hd_model *m, int rs, unsigned char v, unsigned long long t)
+{
+  unsigned long exec = HD_T_EXEC;
+  int op;
+
+  if(t < m->busy_until)
+  {
+    hd_violate(m, HD_V_BUSY);    //A real module ignores the access
+    return;
+  }
+
+  if(rs)
+  {
+    op = HD_OP_DATA;
+    if(m->ac_cgram)
+      m->cgram[m->ac & 0x3F] = v;
+    else
+      m->ddram[m->ac & 0x7F] = v;
+    m->ac = m->inc ? m->ac + 1 : m->ac - 1;
+  }
+  else if(v & 0x80)              //Set DDRAM address
+  {
+    op = HD_OP_CMD;
+    m->ac = v & 0x7F;
+    m->ac_cgram = 0;
+  }
+  else if(v & 0x40)              //Set CGRAM address
+  {
+    op = HD_OP_CMD;
+    m->ac = v & 0x3F;
+    m->ac_cgram = 1;
+  }
+  else if(v & 0x20)              //Function set
+  {
+    op = m->configured ? HD_OP_CMD : HD_OP_INIT;
+    m->bits  = (v & 0x10) ? 8 : 4;
+    m->lines = (v & 0x08) ? 2 : 1;
+    m->nibble = 0;
+  }
+  else if(v & 0x10)              //Cursor/display shift
+  {
+    op = HD_OP_CMD;
+    if(!(v & 0x08))
+      m->ac = (v & 0x04) ? m->ac + 1 : m->ac - 1;
+  }
+  else if(v & 0x08)              //Display on/off control
+  {
+    op = HD_OP_CMD;
+    m->display_on = (v & 0x04) != 0;
+  }
+  else if(v & 0x04)              //Entry mode set
+  {
+    op = HD_OP_CMD;
+    m->inc = (v & 0x02) != 0;
+  }
+  else if(v & 0x02)              //Return home
+  {
+    op = HD_OP_HOME;
+    exec = HD_T_HOME;
+    m->ac = 0;
+    m->ac_cgram = 0;
+  }
+  else if(v & 0x01)              //Clear display
+  {
+    op = HD_OP_HOME;
+    exec = HD_T_HOME;
+    memset(m->ddram, ' ', sizeof(m->ddram));
+    m->ac = 0;
+    m->ac_cgram = 0;
+    m->inc = 1;
+  }
+  else
+  {
+    return;                      //0x00 is not an instruction
+  }
+
+  hd_book_slack(m, t);
+
+  if(op != HD_OP_INIT && op != HD_OP_DATA)
+    m->configured = 1;
+
+  m->ops[op]++;
+  m->last_op = op;
+  m->busy_until = t + exec;
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: hd_model_pins
+
+   Parameters: Model, new port state and time of the change in ns
+ 
+   Return:  None
+ 
+   Description: Call after every GPIO store (times must not decrease)
+ ---------------------------------------------------------------------------*/
+void hd_model_pins(hd_model *m, unsigned long pins, unsigned long long t_ns)
+{
+  unsigned long changed = pins ^ m->pins;
+  int e_before = (m->pins & m->e) != 0;
+  int e_after  = (pins & m->e) != 0;
+
+  if(!changed)
+    return;
+
+  //Control and data changes
+  if(changed & (m->rs | m->rw))
+  {
+    if(m->e_seen && t_ns - m->t_fall < HD_T_H)
+      hd_violate(m, HD_V_HOLD);
+    m->t_ctrl = t_ns;
+  }
+  if(changed & hd_data_mask(m))
+  {
+    if(!e_before && m->e_seen && t_ns - m->t_fall < HD_T_H)
+      hd_violate(m, HD_V_HOLD);
+    m->t_data = t_ns;
+  }
+  m->pins = pins;
+
+  if(!e_before && e_after)                //Rising edge
+  {
+    if(t_ns < HD_T_POWER)
+      hd_violate(m, HD_V_POWER);
+    if(t_ns - m->t_ctrl < HD_T_AS)
+      hd_violate(m, HD_V_AS);
+    if(m->e_seen && t_ns - m->t_rise < HD_T_CYCE)
+      hd_violate(m, HD_V_CYCE);
+    m->t_rise = t_ns;
+  }
+  else if(e_before && !e_after)           //Falling edge: latch
+  {
+    int rs = (pins & m->rs) != 0;
+    unsigned char v = hd_bus(m);
+
+    if(t_ns - m->t_rise < HD_T_PWEH)
+      hd_violate(m, HD_V_PWEH);
+    if(t_ns - m->t_data < HD_T_DSW)
+      hd_violate(m, HD_V_DSW);
+    m->t_fall = t_ns;
+    m->e_seen = 1;
+
+    if(m->rw && (pins & m->rw))
+      return;                             //Read cycle, nothing latched
+
+    if(m->bits == 8)
+    {
+      hd_execute(m, rs, v, t_ns);
+    }
+    else if(!m->nibble)
+    {
+      m->hi = v & 0xF0;
+      m->nibble = 1;
+    }
+    else
+    {
+      m->nibble = 0;
+      hd_execute(m, rs, m->hi | (v >> 4), t_ns);
+    }
+  }
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: hd_model_flush
+
+   Parameters: Model and the time the driver finished (its last wait done)
+ 
+   Return:  None
+ 
+   Description: Books the wait after the last op, which no later access
+                closes; call once at the end of a run, before the report
+ ---------------------------------------------------------------------------*/
+void hd_model_flush(hd_model *m, unsigned long long t_ns)
+{
+  hd_book_slack(m, t_ns);
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: hd_model_line
+
+   Parameters: Model, display line (0/1), buffer and visible width
+ 
+   Return:  None
+ 
+   Description: Copies the visible DDRAM of a line as a C string; CGRAM
+                characters 0-7 are shown as their digit
+ ---------------------------------------------------------------------------*/
+void hd_model_line(const hd_model *m, int line, char *buf, int len)
+{
+  const unsigned char *p = &m->ddram[line ? 0x40 : 0x00];
+
+  for(int i = 0; i < len; i++)
+  {
+    unsigned char c = p[i];
+    buf[i] = c < 8 ? '0' + c : (c < 0x20 || c > 0x7E ? '#' : (char)c);
+  }
+  buf[len] = '\0';
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: hd_model_report
+
+   Parameters: Model and output stream
+ 
+   Return:  None
+ 
+   Description: Prints violations, wait time per operation class and the
+                screen contents
+ ---------------------------------------------------------------------------*/
+void hd_model_report(const hd_model *m, FILE *out)
+{
+  char line[17];
+
+  fprintf(out, "Timing violations:\n");
+  for(int i = 0; i < HD_V_KINDS; i++)
+    fprintf(out, "  %-22s %lu\n", hd_v_names[i], m->violations[i]);
+
+  fprintf(out, "Wait beyond datasheet minimum:\n");
+  for(int i = 0; i < HD_OP_KINDS; i++)
+  {
+    unsigned long long avg = m->booked[i] ? m->wasted[i] / m->booked[i] : 0;
+
+    fprintf(out, "  %-12s %6lu ops  total %10llu ns  avg %8llu ns  max %8llu ns\n",
+            hd_op_names[i], m->ops[i], m->wasted[i], avg, m->wasted_max[i]);
+  }
+
+  fprintf(out, "Screen (%s, %d-bit, %d line%s):\n", m->display_on ? "on" : "off",
+          m->bits, m->lines, m->lines > 1 ? "s" : "");
+  hd_model_line(m, 0, line, 16);
+  fprintf(out, "  [%s]\n", line);
+  hd_model_line(m, 1, line, 16);
+  fprintf(out, "  [%s]\n", line);
+}
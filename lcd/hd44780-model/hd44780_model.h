@@ -0,0 +1,91 @@
+/*--------------------------------------------------------------
+ File:      hd44780_model.h
+ Purpose:   Host-side HD44780 behavioral model with timing checks
+ Compiler:  any C99 host compiler (gcc, clang, MSVC)
+ System:    PC, fed with the GPIO stores of the LPC21xx LCD drivers
+----------------------------------------------------------------*/
+
+#ifndef   __HD44780_MODEL_H
+#define   __HD44780_MODEL_H
+
+#include <stdio.h>
+
+/*
+   Datasheet minimums in ns, 2.7-4.5 V column (the LPC21xx boards run the
+   module at 3.3 V). Execution times are for fosc = 270 kHz.
+*/
+#define HD_T_AS        60         //RS/RW setup before E rises
+#define HD_T_H         10         //RS/RW/data hold after E falls
+#define HD_T_PWEH      450        //E high pulse width
+#define HD_T_CYCE      1000       //E cycle time (rise to rise)
+#define HD_T_DSW       195        //Data setup before E falls
+#define HD_T_POWER     40000000UL //Vcc rise to first access
+#define HD_T_EXEC      37000UL    //Most instructions and data writes
+#define HD_T_HOME      1520000UL  //Clear display / return home
+
+//Checked timing rules
+#define HD_V_POWER     0          //Access before power-on delay
+#define HD_V_AS        1          //RS/RW setup
+#define HD_V_PWEH      2          //Enable pulse too short
+#define HD_V_CYCE      3          //Enable cycle too short
+#define HD_V_DSW       4          //Data setup
+#define HD_V_HOLD      5          //RS/RW/data hold
+#define HD_V_BUSY      6          //Write while the previous instruction executes
+#define HD_V_KINDS     7
+
+//Operation classes for the wait-time report
+#define HD_OP_DATA     0          //DDRAM/CGRAM data write
+#define HD_OP_CMD      1          //Instruction with 37 us execution
+#define HD_OP_HOME     2          //Clear display / return home
+#define HD_OP_INIT     3          //Function sets of the reset sequence
+#define HD_OP_KINDS    4
+
+typedef struct
+{
+  //Wiring (port bit masks)
+  unsigned long rs, rw, e;
+  unsigned long d[8];                 //D0-D7, 0 where not wired
+
+  //Bus state
+  unsigned long      pins;
+  unsigned long long t_ctrl;          //Last RS/RW change
+  unsigned long long t_data;          //Last data line change
+  unsigned long long t_rise, t_fall;  //Last E edges
+  int                e_seen;          //E has pulsed at least once
+
+  //Controller state
+  int                bits;            //Interface data length (8 after reset)
+  int                nibble;          //4-bit: high nibble already latched
+  unsigned char      hi;
+  unsigned long long busy_until;
+  int                last_op;
+  unsigned char      ddram[128];
+  unsigned char      cgram[64];
+  unsigned char      ac;              //Address counter
+  int                ac_cgram;        //AC points into CGRAM
+  int                inc;             //Entry mode I/D
+  int                lines;           //Function set N (1 or 2)
+  int                display_on;
+  int                configured;      //An instruction other than function set ran
+
+  //Statistics
+  unsigned long      violations[HD_V_KINDS];
+  unsigned long      ops[HD_OP_KINDS];
+  unsigned long      booked[HD_OP_KINDS];   //Ops whose wait has ended
+  unsigned long long wasted[HD_OP_KINDS];   //Wait beyond busy time
+  unsigned long long wasted_max[HD_OP_KINDS];
+} hd_model;
+
+//Function Prototypes
+void hd_model_init(hd_model *m, unsigned long rs, unsigned long rw,
+                   unsigned long e, const unsigned long d[8]);
+
+void hd_model_pins(hd_model *m, unsigned long pins, unsigned long long t_ns);
+
+void hd_model_flush(hd_model *m, unsigned long long t_ns);
+
+void hd_model_line(const hd_model *m, int line, char *buf, int len);
+
+void hd_model_report(const hd_model *m, FILE *out);
+
+#endif //__HD44780_MODEL_H
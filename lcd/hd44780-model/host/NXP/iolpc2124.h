@@ -0,0 +1,13 @@
+/*--------------------------------------------------------------
+ File:      iolpc2124.h (host stand-in)
+ Purpose:   Plain variables in place of the LPC2124 registers, so the
+            LCD drivers compile on a PC for lcdsim
+----------------------------------------------------------------*/
+
+#ifndef   __IOLPC2124_HOST_H
+#define   __IOLPC2124_HOST_H
+
+extern volatile unsigned long PINSEL0;
+extern volatile unsigned long IO0DIR;
+
+#endif //__IOLPC2124_HOST_H
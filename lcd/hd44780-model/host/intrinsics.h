@@ -0,0 +1,18 @@
+/*--------------------------------------------------------------
+ File:      intrinsics.h
+ Purpose:   Host stand-in for the IAR interrupt intrinsics
+ Compiler:  any host C compiler
+ System:    host PC (single thread, no interrupts)
+----------------------------------------------------------------*/
+
+#ifndef   __HOST_INTRINSICS_H
+#define   __HOST_INTRINSICS_H
+
+typedef unsigned int __istate_t;
+
+#define __get_interrupt_state()     0U
+#define __set_interrupt_state(s)    ((void)(s))
+#define __disable_interrupt()       ((void)0)
+#define __enable_interrupt()        ((void)0)
+
+#endif //__HOST_INTRINSICS_H
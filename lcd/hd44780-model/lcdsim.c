@@ -0,0 +1,129 @@
+/*----------------------------------------------------------------------------
+    File name   : lcdsim.c
+
+    Description : runs the teachLDC-lib LCD driver on the PC against the
+                  HD44780 model and prints the timing report
+
+    Procesor    : host PC
+
+    Note        : Build from the repository root, picking the board wiring
+                  the driver should use. display-hello (LCD_BOARD_HELLO)
+                  and projj.c (LCD_BOARD_PROJJ) link the same driver, so
+                  this build covers them too (LCD_BOARD_TEACH, _HELLO or
+                  _PROJJ):
+
+      cc -DLCD_BOARD_TEACH -Ilcd/hd44780-model/host -Ilcd/teachLDC-lib
+         -include lcd/hd44780-model/sim_gpio.h
+         lcd/hd44780-model/lcdsim.c lcd/hd44780-model/hd44780_model.c
+         lcd/teachLDC-lib/lcd.c lcd/teachLDC-lib/lcd_bar.c -o lcdsim
+
+                  After the text screen, the lcd_bar.c bar graph is moved
+                  through every level up and down on line 2; each one-step
+                  move must cost exactly LCD_BAR_STEP_OPS bus operations
+                  (DDRAM address plus one cell), else the run fails.
+
+                  Each GPIO store costs SIM_STORE_NS; the driver's waits
+                  advance simulated time exactly, so the report shows the
+                  timing the driver asks for, independent of loop
+                  calibration.
+ ----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../hal/lcd_bind.h"
+#include "lcd.h"
+#include "lcd_bar.h"
+#include "hd44780_model.h"
+
+#ifndef SIM_STORE_NS
+#define SIM_STORE_NS  333          //One VPB GPIO store at PCLK = 3 MHz
+#endif
+
+#define LCD_BAR_STEP_OPS  2        //Bus operations per one-step bar move
+
+volatile unsigned long PINSEL0;
+volatile unsigned long IO0DIR;
+
+static hd_model           lcd;
+static unsigned long      port;
+static unsigned long long now;
+
+void sim_gpio_set(unsigned long mask)
+{
+  now += SIM_STORE_NS;
+  port |= mask;
+  hd_model_pins(&lcd, port, now);
+}
+
+void sim_gpio_clr(unsigned long mask)
+{
+  now += SIM_STORE_NS;
+  port &= ~mask;
+  hd_model_pins(&lcd, port, now);
+}
+
+void sim_delay_us(unsigned int us)
+{
+  now += (unsigned long long)us * 1000;
+}
+
+//Instructions and data writes the model has executed so far
+static unsigned long bus_ops(void)
+{
+  unsigned long n = 0;
+
+  for(int k = 0; k < HD_OP_KINDS; k++)
+    n += lcd.ops[k];
+  return n;
+}
+
+//Moves the bar to a level and returns the bus operations it took
+static unsigned long bar_move(lcd_bar *bar, unsigned int level)
+{
+  unsigned long before = bus_ops();
+
+  lcd_bar_set(bar, level);
+  return bus_ops() - before;
+}
+
+int main(int argc, char **argv)
+{
+  unsigned long d[8] = { 0 };
+  int mode = argc > 1 ? atoi(argv[1]) : LCD_BUS_WIDTH;
+  lcd_bar bar;
+  unsigned long full;
+  int bad = 0;
+
+#if LCD_BUS_WIDTH == 8
+  d[0] = GPIO_BIT(LCD_PIN_D0);
+  d[1] = GPIO_BIT(LCD_PIN_D1);
+  d[2] = GPIO_BIT(LCD_PIN_D2);
+  d[3] = GPIO_BIT(LCD_PIN_D3);
+#endif
+  d[4] = GPIO_BIT(LCD_PIN_D4);
+  d[5] = GPIO_BIT(LCD_PIN_D5);
+  d[6] = GPIO_BIT(LCD_PIN_D6);
+  d[7] = GPIO_BIT(LCD_PIN_D7);
+  hd_model_init(&lcd, LCD_MASK_RS, LCD_MASK_RW, LCD_MASK_E, d);
+
+  init_lcd_mode(mode);
+  lcd_print("Hello World!");
+  write_cmd(0xC0);
+  lcd_print("LPC2124 LCD Test");
+
+  lcd_bar_load_glyphs();
+  lcd_bar_init(&bar, LCD_BAR_ROW2);
+  full = bar_move(&bar, 0);
+  for(unsigned int level = 1; level <= LCD_BAR_STEPS; level++)
+    bad += bar_move(&bar, level) != LCD_BAR_STEP_OPS;
+  for(unsigned int level = LCD_BAR_STEPS; level-- > 0; )
+    bad += bar_move(&bar, level) != LCD_BAR_STEP_OPS;
+  bar_move(&bar, LCD_BAR_STEPS / 2 + 1);
+
+  printf("lcd.c, %d-bit mode, %llu us simulated\n", mode, now / 1000);
+  printf("lcd_bar: first draw %lu bus ops, %d of %d one-step moves not %d ops\n",
+         full, bad, 2 * LCD_BAR_STEPS, LCD_BAR_STEP_OPS);
+  hd_model_flush(&lcd, now);
+  hd_model_report(&lcd, stdout);
+  return bad ? EXIT_FAILURE : EXIT_SUCCESS;
+}
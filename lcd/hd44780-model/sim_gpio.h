@@ -0,0 +1,21 @@
+/*--------------------------------------------------------------
+ File:      sim_gpio.h
+ Purpose:   Routes the LCD driver's GPIO stores and waits into lcdsim
+            (force-included when compiling the driver for the host)
+----------------------------------------------------------------*/
+
+#ifndef   __SIM_GPIO_H
+#define   __SIM_GPIO_H
+
+void sim_gpio_set(unsigned long mask);
+void sim_gpio_clr(unsigned long mask);
+void sim_delay_us(unsigned int us);
+
+#define GPIO_SET(m)        sim_gpio_set(m)
+#define GPIO_CLR(m)        sim_gpio_clr(m)
+#define GPIO_READ()        0UL
+#define GPIO_DIR_OUT(m)    ((void)(m))
+#define GPIO_DIR_IN(m)     ((void)(m))
+#define LCD_DELAY_US(us)   sim_delay_us(us)
+
+#endif //__SIM_GPIO_H
@@ -0,0 +1,283 @@
+/*----------------------------------------------------------------------------
+    File name   : cfgstore.c
+
+    Description : wear-levelled, CRC-checked configuration log in on-chip
+                  flash, written through the LPC21xx IAP routines
+
+    Procesor    : Philips LPC2124 MCU with ARM7TDMI-s Core
+
+    Note        : Each save appends one 256-byte record (magic, sequence,
+                  length, CRC-32, payload) to the active sector. When it is
+                  full the other sector is erased and the log continues
+                  there, so each sector is erased once per CFG_RECORDS
+                  saves. The newest record whose CRC checks out wins:
+                  a write or erase cut short by a power failure only loses
+                  the record being written, never the previous one.
+
+                [Please refer to LPC2124 user manual, chapter "Flash memory
+                 system and programming", IAP commands]
+ ----------------------------------------------------------------------------*/
+
+#include <intrinsics.h>
+#include "cfgstore.h"
+
+#define IAP_LOCATION      0x7FFFFFF1   //IAP entry (Thumb)
+#define IAP_PREPARE       50
+#define IAP_COPY          51
+#define IAP_ERASE         52
+#define IAP_CMD_SUCCESS   0
+
+#define CFG_MAGIC         0x31474643   //"CFG1"
+#define CFG_BLANK         0xFFFFFFFF
+#define CFG_HDR_WORDS     4            //magic, seq, length, crc
+#define CFG_WORDS         (CFG_RECORD_SIZE / 4)
+
+cfg_iap_fn cfg_iap = (cfg_iap_fn)IAP_LOCATION;
+
+static unsigned int cfg_buf[CFG_WORDS];  //Word-aligned RAM source for IAP_COPY
+static int          cfg_sector = -1;     //Sector holding the newest record (0/1)
+static int          cfg_next;            //Next free slot in that sector
+static unsigned int cfg_seq;             //Sequence of the newest record
+
+static const unsigned int cfg_base[2]   = { CFG_ADDR_A, CFG_ADDR_B };
+static const unsigned int cfg_sectnr[2] = { CFG_SECTOR_A, CFG_SECTOR_B };
+
+/*-------------------------------------------------------------------------
+   Function Name: cfg_crc32
+
+   Parameters: Word buffer and number of words
+ 
+   Return:  CRC-32 (reflected, poly 0xEDB88320)
+ 
+   Description: Nibble-table CRC; 64 bytes of table, two lookups per byte
+ ---------------------------------------------------------------------------*/
+static unsigned int cfg_crc32(const unsigned int *p, int words)
+{
+  static const unsigned int tbl[16] =
+  {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+    0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+  };
+  unsigned int crc = 0xFFFFFFFF;
+
+  while(words--)
+  {
+    unsigned int w = *p++;
+
+    for(int n = 0; n < 8; n++)
+    {
+      crc = (crc >> 4) ^ tbl[(crc ^ w) & 0x0F];
+      w >>= 4;
+    }
+  }
+  return ~crc;
+}
+
+//Word address of a slot
+static const unsigned int *cfg_slot(int sector, int slot)
+{
+  return CFG_FLASH(cfg_base[sector] + slot * CFG_RECORD_SIZE);
+}
+
+//Record is complete and intact
+static int cfg_valid(const unsigned int *rec)
+{
+  unsigned int len = rec[2];
+
+  if(rec[0] != CFG_MAGIC || len != sizeof(cfg_data))
+    return 0;
+  return rec[3] == (cfg_crc32(&rec[CFG_HDR_WORDS], len / 4) ^ rec[1]);
+}
+
+//No word of the slot has been programmed
+static int cfg_blank(const unsigned int *rec)
+{
+  for(int i = 0; i < CFG_WORDS; i++)
+  {
+    if(rec[i] != CFG_BLANK)
+      return 0;
+  }
+  return 1;
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: cfg_iap_call
+
+   Parameters: IAP command block (up to 5 words)
+ 
+   Return:  IAP status code
+ 
+   Description: Runs one IAP command with interrupts disabled; the vectors
+                live in flash, which is unreadable while it is programmed
+ ---------------------------------------------------------------------------*/
+static unsigned int cfg_iap_call(unsigned int *command)
+{
+  unsigned int result[3];
+  __istate_t state = __get_interrupt_state();
+
+  __disable_interrupt();
+  cfg_iap(command, result);
+  __set_interrupt_state(state);
+
+  return result[0];
+}
+
+static int cfg_erase(int sector)
+{
+  unsigned int cmd[5];
+
+  cmd[0] = IAP_PREPARE;
+  cmd[1] = cfg_sectnr[sector];
+  cmd[2] = cfg_sectnr[sector];
+  if(cfg_iap_call(cmd) != IAP_CMD_SUCCESS)
+    return 0;
+
+  cmd[0] = IAP_ERASE;
+  cmd[3] = CFG_CCLK_KHZ;
+  return cfg_iap_call(cmd) == IAP_CMD_SUCCESS;
+}
+
+static int cfg_write(int sector, int slot)
+{
+  unsigned int cmd[5];
+
+  cmd[0] = IAP_PREPARE;
+  cmd[1] = cfg_sectnr[sector];
+  cmd[2] = cfg_sectnr[sector];
+  if(cfg_iap_call(cmd) != IAP_CMD_SUCCESS)
+    return 0;
+
+  cmd[0] = IAP_COPY;
+  cmd[1] = cfg_base[sector] + slot * CFG_RECORD_SIZE;
+  cmd[2] = (unsigned int)(unsigned long)cfg_buf;
+  cmd[3] = CFG_RECORD_SIZE;
+  cmd[4] = CFG_CCLK_KHZ;
+  if(cfg_iap_call(cmd) != IAP_CMD_SUCCESS)
+    return 0;
+
+  return cfg_valid(cfg_slot(sector, slot));   //Read back
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: cfg_defaults
+
+   Parameters: Settings to fill
+ 
+   Return:  None
+ 
+   Description: Values used when flash holds no valid record
+ ---------------------------------------------------------------------------*/
+void cfg_defaults(cfg_data *cfg)
+{
+  cfg->threshold  = 50;
+  cfg->pwm_period = BOARD_PCLK_HZ / CFG_PWM_HZ;  //3000 ticks at PCLK = 3 MHz
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: cfg_load
+
+   Parameters: Settings to fill
+ 
+   Return:  1 if a stored record was restored, 0 if defaults were used
+ 
+   Description: Finds the last programmed slot of each sector with a
+                cheap blank scan, then walks back to the newest record with
+                a good CRC; usually a single CRC is computed per sector
+ ---------------------------------------------------------------------------*/
+int cfg_load(cfg_data *cfg)
+{
+  int found = 0;
+
+  cfg_sector = -1;
+  for(int s = 0; s < 2; s++)
+  {
+    int used = 0;
+
+    //IAP programs a record from its lowest word up, so a slot with a
+    //blank magic word was never started
+    while(used < CFG_RECORDS && cfg_slot(s, used)[0] != CFG_BLANK)
+      used++;
+
+    for(int slot = used - 1; slot >= 0; slot--)
+    {
+      const unsigned int *rec = cfg_slot(s, slot);
+
+      if(!cfg_valid(rec))
+        continue;
+
+      if(!found || (int)(rec[1] - cfg_seq) > 0)
+      {
+        const unsigned int *src = &rec[CFG_HDR_WORDS];
+        unsigned int *dst = (unsigned int *)cfg;
+
+        for(unsigned int i = 0; i < sizeof(cfg_data) / 4; i++)
+          dst[i] = src[i];
+
+        cfg_seq    = rec[1];
+        cfg_sector = s;
+        cfg_next   = used;
+        found = 1;
+      }
+      break;
+    }
+  }
+
+  if(!found)
+    cfg_defaults(cfg);
+  return found;
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: cfg_save
+
+   Parameters: Settings to store
+ 
+   Return:  1 on success, 0 if flash could not be programmed
+ 
+   Description: Appends a record to the active sector; when it is full
+                (or a slot fails to program) the other sector is erased
+                and the log moves there. cfg_load() must run first.
+ ---------------------------------------------------------------------------*/
+int cfg_save(const cfg_data *cfg)
+{
+  const unsigned int *src = (const unsigned int *)cfg;
+  int sector = cfg_sector < 0 ? 0 : cfg_sector;
+  int slot   = cfg_sector < 0 ? CFG_RECORDS : cfg_next;
+
+  for(int i = 0; i < CFG_WORDS; i++)
+    cfg_buf[i] = CFG_BLANK;
+  for(unsigned int i = 0; i < sizeof(cfg_data) / 4; i++)
+    cfg_buf[CFG_HDR_WORDS + i] = src[i];
+  cfg_buf[0] = CFG_MAGIC;
+  cfg_buf[1] = cfg_seq + 1;
+  cfg_buf[2] = sizeof(cfg_data);
+  cfg_buf[3] = cfg_crc32(&cfg_buf[CFG_HDR_WORDS], sizeof(cfg_data) / 4) ^ cfg_buf[1];
+
+  //Rest of the active sector, skipping slots left dirty by a torn write
+  for(; slot < CFG_RECORDS; slot++)
+  {
+    if(cfg_blank(cfg_slot(sector, slot)) && cfg_write(sector, slot))
+      break;
+  }
+
+  if(slot >= CFG_RECORDS)
+  {
+    sector = cfg_sector < 0 ? 0 : sector ^ 1;
+    if(!cfg_erase(sector))
+      return 0;
+    for(slot = 0; slot < CFG_RECORDS; slot++)
+    {
+      if(cfg_write(sector, slot))
+        break;
+    }
+    if(slot >= CFG_RECORDS)
+      return 0;
+  }
+
+  cfg_seq    = cfg_buf[1];
+  cfg_sector = sector;
+  cfg_next   = slot + 1;
+  return 1;
+}
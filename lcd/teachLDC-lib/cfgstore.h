@@ -0,0 +1,52 @@
+/*--------------------------------------------------------------
+ File:      cfgstore.h
+ Purpose:   Persistent configuration in on-chip flash (IAP)
+ Compiler:  IAR EW 5.5
+ System:    Philips LPC2124 MCU with ARM7TDMI-s core
+----------------------------------------------------------------*/
+
+#ifndef   __CFGSTORE_H
+#define   __CFGSTORE_H
+
+#include "../../hal/board.h"
+
+/*
+   Two 8 KB sectors at the top of user flash hold a log of 256-byte
+   records. They must be kept out of the code region, and the top 32
+   bytes of RAM must stay free for the IAP routines: link with
+   lpc2124_cfg.icf, which reserves both.
+*/
+#define CFG_SECTOR_A      15          //0x0003A000 - 0x0003BFFF
+#define CFG_SECTOR_B      16          //0x0003C000 - 0x0003DFFF
+#define CFG_ADDR_A        0x0003A000
+#define CFG_ADDR_B        0x0003C000
+#define CFG_SECTOR_SIZE   0x2000
+#define CFG_RECORD_SIZE   256         //Smallest IAP write
+#define CFG_RECORDS       (CFG_SECTOR_SIZE / CFG_RECORD_SIZE)
+#define CFG_PWM_HZ        1000        //Default PWM frequency
+#define CFG_CCLK_KHZ      (BOARD_CCLK_HZ / 1000)   //CCLK passed to the IAP erase/write calls
+
+//Flash read access; a host build maps this onto a simulated array
+#ifndef CFG_FLASH
+#define CFG_FLASH(addr)   ((const unsigned int *)(unsigned long)(addr))
+#endif
+
+//Settings restored at reset
+typedef struct
+{
+  int threshold;       //Gain threshold in percent (keypad entry)
+  int pwm_period;      //PWMMR0 + 1, in PCLK ticks
+} cfg_data;
+
+//IAP entry point type; cfg_iap can be pointed at a host stand-in
+typedef void (*cfg_iap_fn)(unsigned int command[], unsigned int result[]);
+extern cfg_iap_fn cfg_iap;
+
+//Function Prototypes
+void cfg_defaults(cfg_data *cfg);
+
+int cfg_load(cfg_data *cfg);
+
+int cfg_save(const cfg_data *cfg);
+
+#endif //__CFGSTORE_H
@@ -0,0 +1,183 @@
+/*----------------------------------------------------------------------------
+    File name   : cfgstore_host.c
+
+    Description : host check for cfgstore.c. Sectors 15 and 16 are
+                  simulated in RAM behind an IAP stand-in that enforces
+                  the command rules (prepare before erase/copy, only the
+                  two config sectors, 256-byte aligned copies, program
+                  only clears bits). A long run of saves is cut by
+                  simulated power failures in the middle of erases and
+                  copies (the save is abandoned at that point); after each
+                  one cfg_load() must return either the new record or the
+                  previous one.
+
+    Procesor    : host PC
+
+    Note        : Build and run from lcd/teachLDC-lib:
+
+      cc -I../hd44780-model/host cfgstore_host.c -o cfgstore_host
+      ./cfgstore_host
+
+                  The stand-in reads the copy source straight from
+                  cfg_buf: a host pointer does not fit the 32-bit IAP
+                  command word.
+ ----------------------------------------------------------------------------*/
+
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SAVES       5000
+#define TEAR_EVERY  37      //Every n-th save loses power inside an IAP call
+
+#define IAP_SECTOR_NOT_PREPARED  9
+#define IAP_INVALID_SECTOR       7
+#define IAP_DST_ADDR_ERROR       3
+#define IAP_COUNT_ERROR          6
+
+static unsigned int flash[2][0x2000 / 4];
+
+//Maps the sector A/B addresses onto the simulated array
+#define CFG_FLASH(addr)  (&flash[(addr) >= 0x3C000][((addr) - ((addr) >= 0x3C000 ? 0x3C000 : 0x3A000)) / 4])
+
+#include "cfgstore.c"
+
+static int prepared = -1;         //Sector of the last IAP_PREPARE
+static int tear_at  = -1;         //IAP call index to cut short
+static int iap_calls;
+static int erases[2];
+static int tears;
+static jmp_buf power_fail;
+
+static void iap_sim(unsigned int command[], unsigned int result[])
+{
+  int call = iap_calls++;
+
+  result[0] = IAP_CMD_SUCCESS;
+  switch(command[0])
+  {
+  case IAP_PREPARE:
+    if(command[1] != command[2] || command[1] < CFG_SECTOR_A || command[1] > CFG_SECTOR_B)
+    {
+      result[0] = IAP_INVALID_SECTOR;
+      return;
+    }
+    prepared = command[1];
+    return;
+
+  case IAP_ERASE:
+  {
+    int s = command[1] - CFG_SECTOR_A;
+
+    if(prepared != (int)command[1] || command[2] != command[1])
+    {
+      result[0] = IAP_SECTOR_NOT_PREPARED;
+      return;
+    }
+    prepared = -1;
+    erases[s]++;
+    if(call == tear_at)
+    {
+      //Partly erased: leading words blank, the rest garbage
+      int n = rand() % (0x2000 / 4);
+
+      for(int i = 0; i < 0x2000 / 4; i++)
+        flash[s][i] = i < n ? CFG_BLANK : (unsigned int)rand();
+      longjmp(power_fail, 1);
+    }
+    memset(flash[s], 0xFF, sizeof flash[s]);
+    return;
+  }
+
+  case IAP_COPY:
+  {
+    unsigned int dst = command[1];
+    int s = dst >= CFG_ADDR_B;
+    int n = command[3] / 4;
+    unsigned int *d;
+
+    if(dst < CFG_ADDR_A || dst >= CFG_ADDR_B + CFG_SECTOR_SIZE || (dst & 0xFF))
+    {
+      result[0] = IAP_DST_ADDR_ERROR;
+      return;
+    }
+    if(command[3] != CFG_RECORD_SIZE)
+    {
+      result[0] = IAP_COUNT_ERROR;
+      return;
+    }
+    if(prepared != CFG_SECTOR_A + s)
+    {
+      result[0] = IAP_SECTOR_NOT_PREPARED;
+      return;
+    }
+    prepared = -1;
+    d = (unsigned int *)CFG_FLASH(dst);
+    if(call == tear_at)
+      n = rand() % n;
+    for(int i = 0; i < n; i++)
+      d[i] &= cfg_buf[i];                 //Programming only clears bits
+    if(call == tear_at)
+      longjmp(power_fail, 1);
+    return;
+  }
+  }
+}
+
+int main(void)
+{
+  cfg_data cfg;
+  cfg_data got;
+  int last = -1;                          //Threshold of the newest good save
+  int bad = 0;
+
+  cfg_iap = iap_sim;
+  memset(flash, 0xFF, sizeof flash);
+
+  for(int i = 0; i < SAVES; i++)
+  {
+    //Every save starts from a reset
+    int found = cfg_load(&got);
+
+    if(found != (last >= 0) || (found && got.threshold != last))
+    {
+      printf("save %d: loaded %d (found %d), expected %d\n", i, got.threshold, found, last);
+      bad++;
+    }
+
+    cfg_defaults(&cfg);
+    cfg.threshold = i;
+    //Second call of the save: the copy, or the erase when the log moves
+    tear_at = (i % TEAR_EVERY == TEAR_EVERY - 1) ? iap_calls + 1 : -1;
+    if(!setjmp(power_fail))
+    {
+      if(!cfg_save(&cfg))
+      {
+        printf("save %d failed\n", i);
+        bad++;
+      }
+      else
+        last = i;
+      continue;
+    }
+
+    //Power lost during the save: old or new value, nothing else
+    tears++;
+    prepared = -1;
+    found = cfg_load(&got);
+    if(found && (got.threshold == i || got.threshold == last))
+      last = got.threshold;
+    else if(found || last >= 0)
+    {
+      printf("save %d: torn write left %d (found %d), expected %d or %d\n",
+             i, got.threshold, found, last, i);
+      bad++;
+    }
+  }
+
+  printf("%d saves, %d torn, %d mismatches\n", SAVES, tears, bad);
+  printf("erases: sector %d %d, sector %d %d (one per %d records)\n",
+         CFG_SECTOR_A, erases[0], CFG_SECTOR_B, erases[1], CFG_RECORDS);
+  return bad ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -1,49 +1,156 @@
-#include "LCD.h"
+#include "lcd.h"
+#ifdef LCD_BENCH
+#include "lcd_bench.h"
+#endif
+
+//Board wiring; override with -DLCD_BOARD_xxx in the project options
+#if !defined(LCD_BOARD_HELLO) && !defined(LCD_BOARD_PROJJ) && !defined(LCD_BOARD_TEACH) && \
+    !defined(LCD_BUS_WIDTH)
+#define LCD_BOARD_TEACH     //8-bit bus on P0.0-7, RS=P0.8, RW=P0.9, E=P0.10
+#endif
+#include "../../hal/lcd_bind.h"
+
+//Busy-loop calibration (CCLK = 12 MHz crystal, no PLL, ~6 cycles per loop)
+#ifndef LCD_LOOPS_PER_US
+#define LCD_LOOPS_PER_US  2
+#endif
+
+//HD44780 minimum timings (datasheet, fosc = 250 kHz worst case), in us
+#define LCD_T_POWER_US    40000   //Vcc rise to first command
+#define LCD_T_E_US        1       //E pulse width (PWeh >= 450 ns)
+#define LCD_T_NIBBLE_US   1       //E low between nibbles (tcycE >= 1000 ns)
+#define LCD_T_EXEC_US     40      //Most commands and data writes
+#define LCD_T_HOME_US     1640    //Clear display / return home
+#define LCD_T_RESET1_US   4100    //After first 0x30 of the reset sequence
+#define LCD_T_RESET2_US   100     //After second and third 0x30
+
+//A nibble on D4-D7: 4-bit wiring carries it as is, 8-bit wiring in the upper half
+#if LCD_BUS_WIDTH == 8
+#define LCD_NIBBLE(n)     ((n) << 4)
+#else
+#define LCD_NIBBLE(n)     (n)
+#endif
+
+static int lcd_bits = LCD_BUS_WIDTH;   //Active bus mode
 
 void init_mc()
 {
   PINSEL0=0x00000000;
-  IO0DIR=0X0000FFFF;
-  //IO0SET=0x0000ffff;
+  gpio_init();
+  GPIO_DIR_OUT(0x0000FFFF);
 }
 void delay(unsigned int val)
 {
-  for(int i=1;i<=val;i++)
+  for(volatile unsigned int i=1;i<=val;i++)
+  {
+  }
+}
+
+//Busy wait; the host model (lcd/hd44780-model) replaces it with simulated
+//time, and LCD_BENCH builds time it so lcd_bench can split bus and wait time
+#ifndef LCD_DELAY_US
+#ifdef LCD_BENCH
+#define LCD_DELAY_US(us)  lcd_bench_wait((us) * LCD_LOOPS_PER_US)
+#else
+#define LCD_DELAY_US(us)  delay((us) * LCD_LOOPS_PER_US)
+#endif
+#endif
+
+static void lcd_delay_us(unsigned int us)
+{
+  LCD_DELAY_US(us);
+}
+
+//One enable strobe with the minimum pulse width
+static void lcd_strobe(void)
+{
+  lcd_bus_e_high();
+  lcd_delay_us(LCD_T_E_US);
+  lcd_bus_e_low();
+}
+
+static void lcd_write(char value, int rs)
+{
+  if(lcd_bits == LCD_MODE_8BIT)
   {
+    lcd_bus_setup(rs, value);
+    lcd_strobe();
   }
+  else
+  {
+    lcd_bus_setup(rs, LCD_NIBBLE((value >> 4) & 0x0F));   //High nibble
+    lcd_strobe();
+    lcd_delay_us(LCD_T_NIBBLE_US);
+    lcd_bus_data_e_high(LCD_NIBBLE(value & 0x0F));        //Low nibble, RS unchanged
+    lcd_delay_us(LCD_T_E_US);
+    lcd_bus_e_low();
+  }
+
+  //Clear (0x01) and home (0x02/0x03) are the only slow instructions
+  if(!rs && (unsigned char)value < 0x04)
+    lcd_delay_us(LCD_T_HOME_US);
+  else
+    lcd_delay_us(LCD_T_EXEC_US);
 }
+
+//Single strobe of the upper four data bits, used by the reset sequence
+static void lcd_write_reset(char value)
+{
+  if(LCD_BUS_WIDTH == 8)
+    lcd_bus_setup(0, value);
+  else
+    lcd_bus_setup(0, LCD_NIBBLE((value >> 4) & 0x0F));
+  lcd_strobe();
+}
+
 void write_data(char value)
 {
-  IO0SET_bit.P0_8=1;
-  IO0CLR_bit.P0_9=1;
-  IO0SET=value;
-  IO0SET_bit.P0_10=1;
-  delay(100);
-  IO0CLR_bit.P0_10=1;
-  delay(10000);
-  IO0CLR=0x0000FFFF;   
+  lcd_write(value, 1);
 }
 
 void write_cmd(char value)
 {
-  IO0CLR_bit.P0_8=1;
-  IO0CLR_bit.P0_9=1;
-  IO0SET=value;
-  IO0SET_bit.P0_10=1;
-  delay(100);
-  IO0CLR_bit.P0_10=1;
-  delay(10000);
-  IO0CLR=0x0000FFFF;   
+  lcd_write(value, 0);
+}
+
+void lcd_print(const char *str)
+{
+  while(*str)
+  {
+    lcd_write(*str++, 1);
+  }
+}
+
+void init_lcd_mode(int bits)
+{
+  if(LCD_BUS_WIDTH == 4)     //Only D4-D7 are wired
+    bits = LCD_MODE_4BIT;
+
+  lcd_bus_init();
+  lcd_delay_us(LCD_T_POWER_US);
+
+  //Reset by instruction: works from any previous bus mode
+  lcd_write_reset(0x30);
+  lcd_delay_us(LCD_T_RESET1_US);
+  lcd_write_reset(0x30);
+  lcd_delay_us(LCD_T_RESET2_US);
+  lcd_write_reset(0x30);
+  lcd_delay_us(LCD_T_RESET2_US);
+
+  if(bits == LCD_MODE_4BIT)
+  {
+    lcd_write_reset(0x20);
+    lcd_delay_us(LCD_T_EXEC_US);
+  }
+  lcd_bits = bits;
+
+  write_cmd(bits == LCD_MODE_8BIT ? 0x38 : 0x28);   //Function set, 2 lines, 5x8
+  write_cmd(0x0E);                                   //Display on, cursor on
+  write_cmd(0x01);                                   //Clear
+  write_cmd(0x06);                                   //Entry mode, increment
 }
 
 void init_lcd()
 {
-  write_cmd(0x01);
-  delay(100);
-  write_cmd(0x38);
-  delay(100);
-  write_cmd(0x06);
-  delay(100);
-  write_cmd(0x0E);
-  delay(100);
-}
\ No newline at end of file
+  init_lcd_mode(LCD_BUS_WIDTH);
+}
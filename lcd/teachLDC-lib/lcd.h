@@ -1,6 +1,13 @@
-#include <Nxp/iolpc2124.h>
+#include <NXP/iolpc2124.h>
+
+//Bus modes for init_lcd_mode() (4-bit mode uses D4-D7 only)
+#define LCD_MODE_8BIT  8
+#define LCD_MODE_4BIT  4
+
 void init_lcd(void);
+void init_lcd_mode(int bits);
 void init_mc(void);
 void write_data(char);
 void write_cmd(char);
-void delay(unsigned int);
\ No newline at end of file
+void lcd_print(const char *);
+void delay(unsigned int);
@@ -0,0 +1,122 @@
+/*----------------------------------------------------------------------------
+    File name   : lcd_bar.c
+
+    Description : horizontal bar graph with 80-step resolution on one row
+                  of a 16x2 HD44780 display
+
+    Procesor    : Philips LPC2124 MCU with ARM7TDMI-s Core
+
+    Note        : CGRAM characters 0-3 hold bars 1-4 columns wide; an empty
+                  cell is a space and a full cell is ROM character 0xFF.
+                  The glyphs are loaded once, after that an update only
+                  rewrites the cells whose fill changed. Typical use:
+
+                      lcd_bar_load_glyphs();
+                      lcd_bar_init(&bar, LCD_BAR_ROW2);
+                      ...
+                      lcd_bar_set(&bar, adc * LCD_BAR_STEPS / 1024);
+ ----------------------------------------------------------------------------*/
+
+#include "lcd.h"
+#include "lcd_bar.h"
+
+#define LCD_CMD_CGRAM   0x40
+#define LCD_CMD_DDRAM   0x80
+#define LCD_CELL_EMPTY  ' '
+#define LCD_CELL_FULL   0xFF
+#define LCD_CELL_UNSET  0xFF     //Shadow value that forces a redraw
+
+/*-------------------------------------------------------------------------
+   Function Name: lcd_bar_load_glyphs
+
+   Parameters: None
+ 
+   Return:  None
+ 
+   Description: Writes the four partial-block glyphs into CGRAM 0-3 with
+                a single address set (CGRAM auto-increments)
+ ---------------------------------------------------------------------------*/
+void lcd_bar_load_glyphs(void)
+{
+  static const unsigned char rows[4] = { 0x10, 0x18, 0x1C, 0x1E };
+
+  write_cmd(LCD_CMD_CGRAM);
+  for(int g = 0; g < 4; g++)
+  {
+    for(int r = 0; r < 8; r++)
+    {
+      write_data(rows[g]);
+    }
+  }
+  write_cmd(LCD_CMD_DDRAM);   //Back to DDRAM so text writes land on screen
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: lcd_bar_init
+
+   Parameters: Bar object and DDRAM address of its first cell
+ 
+   Return:  None
+ 
+   Description: Binds the bar to a screen position; the next lcd_bar_set()
+                draws every cell
+ ---------------------------------------------------------------------------*/
+void lcd_bar_init(lcd_bar *bar, unsigned char addr)
+{
+  bar->addr = addr;
+  for(int i = 0; i < LCD_BAR_CELLS; i++)
+  {
+    bar->cells[i] = LCD_CELL_UNSET;
+  }
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: lcd_bar_set
+
+   Parameters: Bar object and new level (0..LCD_BAR_STEPS, clamped)
+ 
+   Return:  None
+ 
+   Description: Rewrites only the changed cells. A run of adjacent changed
+                cells shares one DDRAM address command, so moving the bar
+                by one step costs one command and one data write.
+ ---------------------------------------------------------------------------*/
+void lcd_bar_set(lcd_bar *bar, unsigned int level)
+{
+  int cursor = -1;              //Cell the DDRAM address counter points at
+
+  if(level > LCD_BAR_STEPS)
+    level = LCD_BAR_STEPS;
+
+  for(int i = 0; i < LCD_BAR_CELLS; i++)
+  {
+    unsigned char fill;
+
+    if(level >= LCD_BAR_COLS)
+    {
+      fill = LCD_BAR_COLS;
+      level -= LCD_BAR_COLS;
+    }
+    else
+    {
+      fill = level;
+      level = 0;
+    }
+
+    if(bar->cells[i] == fill)
+      continue;
+
+    if(cursor != i)
+      write_cmd(LCD_CMD_DDRAM | (bar->addr + i));
+
+    if(fill == 0)
+      write_data(LCD_CELL_EMPTY);
+    else if(fill == LCD_BAR_COLS)
+      write_data(LCD_CELL_FULL);
+    else
+      write_data(fill - 1);     //CGRAM glyph 0-3
+
+    bar->cells[i] = fill;
+    cursor = i + 1;
+  }
+}
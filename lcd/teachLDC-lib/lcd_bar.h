@@ -0,0 +1,33 @@
+/*--------------------------------------------------------------
+ File:      lcd_bar.h
+ Purpose:   Bar-graph widget using CGRAM partial-block glyphs
+ Compiler:  IAR EW 5.5
+ System:    Philips LPC2124 MCU with ARM7TDMI-s core
+----------------------------------------------------------------*/
+
+#ifndef   __LCD_BAR_H
+#define   __LCD_BAR_H
+
+//Macros
+#define LCD_BAR_CELLS   16                     //Characters per row (16x2 module)
+#define LCD_BAR_COLS    5                      //Pixel columns per character
+#define LCD_BAR_STEPS   (LCD_BAR_CELLS * LCD_BAR_COLS)   //80 levels per row
+
+#define LCD_BAR_ROW1    0x00                   //DDRAM address of line 1
+#define LCD_BAR_ROW2    0x40                   //DDRAM address of line 2
+
+//One bar; keeps a shadow of what is on screen
+typedef struct
+{
+  unsigned char addr;                  //DDRAM address of the first cell
+  unsigned char cells[LCD_BAR_CELLS];  //Columns lit per cell (0..5)
+} lcd_bar;
+
+//Function Prototypes
+void lcd_bar_load_glyphs(void);
+
+void lcd_bar_init(lcd_bar *bar, unsigned char addr);
+
+void lcd_bar_set(lcd_bar *bar, unsigned int level);
+
+#endif //__LCD_BAR_H
@@ -0,0 +1,123 @@
+/*----------------------------------------------------------------------------
+    File name   : lcd_bench.c
+
+    Description : measures LCD write throughput in a given bus mode using
+                  Timer1 as a free-running PCLK counter
+
+    Procesor    : Philips LPC2124 MCU with ARM7TDMI-s Core
+
+    Note        : The driver busy-waits, so the CPU is blocked for the whole
+                  transfer. Define LCD_BENCH for the whole project: lcd.c
+                  then routes its waits through lcd_bench_wait(), which
+                  times them, so the busy time per character splits into
+                  bus time and wait time. Run once per mode and compare,
+                  e.g.
+
+                      lcd_bench_run(LCD_MODE_8BIT, &res8);
+                      lcd_bench_run(LCD_MODE_4BIT, &res4);
+
+                  4-bit mode is only meaningful on an 8-bit wired board
+                  (it then uses D4-D7); a 4-bit board always runs 4-bit.
+
+                  The raw bus figures (toggle rate, bus setups per second)
+                  show the GPIO backend: build once as is and once with
+                  GPIO_BACKEND_FIO (LPC2148) to compare legacy and fast GPIO.
+ ----------------------------------------------------------------------------*/
+
+#include "lcd.h"
+#include "lcd_bench.h"
+
+#if !defined(LCD_BOARD_HELLO) && !defined(LCD_BOARD_PROJJ) && !defined(LCD_BOARD_TEACH) && \
+    !defined(LCD_BUS_WIDTH)
+#define LCD_BOARD_TEACH     //Same default wiring as lcd.c
+#endif
+#include "../../hal/lcd_bind.h"
+
+static unsigned int lcd_bench_wait_ticks;   //Timer1 ticks spent in lcd_bench_wait()
+
+//Elapsed Timer1 ticks converted to events per second
+static unsigned int lcd_bench_rate(unsigned int events, unsigned int ticks)
+{
+  return (unsigned int)(((unsigned long long)events * LCD_BENCH_PCLK_HZ) / ticks);
+}
+
+//Timer1 ticks converted to ns per character of the measured run
+static unsigned int lcd_bench_ns(unsigned int ticks)
+{
+  return (unsigned int)(((unsigned long long)ticks * 1000000000) /
+                        ((unsigned long long)LCD_BENCH_PCLK_HZ * LCD_BENCH_CHARS));
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: lcd_bench_wait
+
+   Parameters: Busy-loop passes (see LCD_LOOPS_PER_US in lcd.c)
+ 
+   Return:  None
+ 
+   Description: lcd.c's wait in LCD_BENCH builds: the usual delay(), with
+                the elapsed Timer1 ticks added to the wait total
+ ---------------------------------------------------------------------------*/
+void lcd_bench_wait(unsigned int loops)
+{
+  unsigned int start = T1TC;
+
+  delay(loops);
+  lcd_bench_wait_ticks += T1TC - start;
+}
+
+/*-------------------------------------------------------------------------
+   Function Name: lcd_bench_run
+
+   Parameters: Bus mode and pointer to the result structure
+ 
+   Return:  None
+ 
+   Description: Re-initializes the LCD in the requested mode, then times
+                LCD_BENCH_CHARS data writes (one line rewritten repeatedly),
+                raw toggles of D7 with E low (ignored by the LCD) and raw
+                bus setups without enable pulses
+ ---------------------------------------------------------------------------*/
+void lcd_bench_run(int mode, lcd_bench_result *res)
+{
+  unsigned int start;
+  unsigned int ticks;
+
+  init_lcd_mode(mode);
+
+  T1TCR = 2;                 //Reset Timer1
+  T1PR  = 0;                 //Count every PCLK
+  T1TCR = 1;                 //Start
+
+  lcd_bench_wait_ticks = 0;
+  start = T1TC;
+  for(int i = 0; i < LCD_BENCH_CHARS; i++)
+  {
+    if((i & 15) == 0)
+      write_cmd(0x80);       //Back to line 1 (not counted as a character)
+    write_data('0' + (i & 7));
+  }
+  ticks = T1TC - start;
+
+  res->mode  = mode;
+  res->ticks = ticks;
+  res->chars_per_sec    = lcd_bench_rate(LCD_BENCH_CHARS, ticks);
+  res->busy_ns_per_char = lcd_bench_ns(ticks);
+  res->wait_ns_per_char = lcd_bench_ns(lcd_bench_wait_ticks);
+  res->bus_ns_per_char  = res->busy_ns_per_char - res->wait_ns_per_char;
+
+  start = T1TC;
+  for(int i = 0; i < LCD_BENCH_BUS; i++)
+  {
+    GPIO_SET(GPIO_BIT(LCD_PIN_D7));
+    GPIO_CLR(GPIO_BIT(LCD_PIN_D7));
+  }
+  res->toggles_per_sec = lcd_bench_rate(LCD_BENCH_BUS, T1TC - start);
+
+  start = T1TC;
+  for(int i = 0; i < LCD_BENCH_BUS; i++)
+  {
+    lcd_bus_setup(1, i);
+  }
+  res->bus_bytes_per_sec = lcd_bench_rate(LCD_BENCH_BUS, T1TC - start);
+}
@@ -0,0 +1,39 @@
+/*--------------------------------------------------------------
+ File:      lcd_bench.h
+ Purpose:   LCD bus throughput benchmark
+ Compiler:  IAR EW 5.5
+ System:    Philips LPC2124 MCU with ARM7TDMI-s core
+----------------------------------------------------------------*/
+
+#ifndef   __LCD_BENCH_H
+#define   __LCD_BENCH_H
+
+#include "../../hal/board.h"
+
+//Macros
+#define LCD_BENCH_PCLK_HZ  BOARD_PCLK_HZ   //Timer1 counts every PCLK
+#define LCD_BENCH_CHARS    160       //Characters written per measured run
+#define LCD_BENCH_BUS      1000      //Iterations of the raw bus measurements
+
+//Result of one run (inspect in the Watch window). The driver blocks for
+//every character; its busy time is split into the part spent driving the
+//bus (stores, call overhead) and the part spent in the datasheet waits.
+//Per-character figures include one cursor command per 16 characters.
+typedef struct
+{
+  int          mode;            //LCD_MODE_8BIT or LCD_MODE_4BIT
+  unsigned int ticks;           //Timer1 ticks for LCD_BENCH_CHARS characters
+  unsigned int chars_per_sec;   //Throughput
+  unsigned int busy_ns_per_char;//CPU time blocked in the driver per character
+  unsigned int bus_ns_per_char; // of which driving the bus
+  unsigned int wait_ns_per_char;// of which in LCD_DELAY_US waits
+  unsigned int toggles_per_sec; //Pin set/clear pairs per second (GPIO backend)
+  unsigned int bus_bytes_per_sec;//Bus setups per second, waits excluded
+} lcd_bench_result;
+
+//Function Prototypes
+void lcd_bench_run(int mode, lcd_bench_result *res);
+
+void lcd_bench_wait(unsigned int loops);   //LCD_DELAY_US of LCD_BENCH builds
+
+#endif //__LCD_BENCH_H
@@ -1,18 +1,26 @@
 #include <Nxp/iolpc2124.h>
-#include "LCD.h"
+#include "lcd.h"
+#include "lcd_bench.h"
+
+#ifdef LCD_BENCH
+lcd_bench_result bench8, bench4;   //Inspect in the Watch window
+#endif
 
 
 void main()
 {
   init_mc();
   delay(10);
+#ifdef LCD_BENCH
+  lcd_bench_run(LCD_MODE_8BIT, &bench8);
+  lcd_bench_run(LCD_MODE_4BIT, &bench4);
+#endif
   init_lcd();
   delay(10);
   char data [] ="Hello World!";
   for (int i=0;i<12;i++)
   {
     write_data(data[i]);
-    delay(10000);
   }
   
 }
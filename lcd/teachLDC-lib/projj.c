@@ -1,16 +1,14 @@
 #include "NXP/iolpc2124.h"
 #include "math.h"
 #include <stdbool.h>
+#include "cfgstore.h"
 
 
-// LCD Pin Definitions
-#define LCD_RS   0    // P0.0 - Register Select
-#define LCD_RW   1    // P0.1 - Read/Write
-#define LCD_E    2    // P0.2 - Enable
-#define LCD_D4   3    // P0.3 - Data bit 4
-#define LCD_D5   4    // P0.4 - Data bit 5
-#define LCD_D6   5    // P0.5 - Data bit 6
-#define LCD_D7   6    // P0.6 - Data bit 7
+// LCD on P0.0-6 (RS=P0.0, RW=P0.1, E=P0.2, D4-D7=P0.3-6): build with
+// LCD_BOARD_PROJJ defined for this file, teachLDC-lib/lcd.c and lcd_bar.c
+#include "lcd.h"
+#include "lcd_bar.h"
+#include "../../hal/gpio_bind.h"
 
 // Keypad Pin Definitions
 #define KP_R1    7    // P0.7  - Row 1
@@ -24,10 +22,6 @@
 
 // LCD Commands
 #define LCD_CLEAR       0x01
-#define LCD_HOME        0x02
-#define LCD_ENTRY_MODE  0x06
-#define LCD_DISPLAY_ON  0x0C
-#define LCD_FUNC_SET    0x28
 #define LCD_LINE1       0x80
 #define LCD_LINE2       0xC0
 
@@ -40,93 +34,12 @@ const char keymap[4][4] = {
     {'O', '0', '=', '+'}
 };
 
-// Delay functions
+// Delay function (keypad debounce and sample period)
 void delay_ms(unsigned int ms) {
     volatile unsigned int i, j;
     for(i = 0; i < ms; i++)
         for(j = 0; j < 100; j++);  // Much faster
 }
-void delay_us(unsigned int us) {
-    volatile unsigned int i;
-    for(i = 0; i < us/10; i++);  // Much faster
-}
-
-void lcd_write(unsigned char data, int rs) {
-    if(rs) IO0SET = (1 << LCD_RS);
-    else   IO0CLR = (1 << LCD_RS);
-    
-    IO0CLR = (1 << LCD_RW);
-    delay_ms(1);
-    
-    // Send high nibble
-    IO0CLR = (0xF << LCD_D4);
-    IO0SET = ((data >> 4) & 0xF) << LCD_D4;
-    IO0SET = (1 << LCD_E);
-    delay_us(1);
-    IO0CLR = (1 << LCD_E);
-    
-    delay_us(1);
-    
-    // Send low nibble
-    IO0CLR = (0xF << LCD_D4);
-    IO0SET = (data & 0xF) << LCD_D4;
-    IO0SET = (1 << LCD_E);
-    delay_us(1);
-    IO0CLR = (1 << LCD_E);
-    
-    delay_ms(2);
-}
-
-void lcd_cmd(unsigned char cmd) {
-    lcd_write(cmd, 0);
-}
-
-void lcd_data(unsigned char data) {
-    lcd_write(data, 1);
-}
-
-void lcd_init(void) {
-    // Set LCD pins as outputs
-    IO0DIR |= (0x7F << 0);
-    
-    delay_ms(20);
-    
-    // Initialize 4-bit mode
-    IO0CLR = (1 << LCD_RS) | (1 << LCD_RW);
-    
-    IO0CLR = (0xF << LCD_D4);
-    IO0SET = (0x3 << LCD_D4);
-    IO0SET = (1 << LCD_E);
-    delay_us(1);
-    IO0CLR = (1 << LCD_E);
-    delay_ms(5);
-    
-    IO0SET = (1 << LCD_E);
-    delay_us(1);
-    IO0CLR = (1 << LCD_E);
-    delay_us(100);
-    IO0SET = (1 << LCD_E);
-    delay_us(1);
-    IO0CLR = (1 << LCD_E);
-    delay_us(100);
-    
-    IO0CLR = (0xF << LCD_D4);
-    IO0SET = (0x2 << LCD_D4);
-    IO0SET = (1 << LCD_E);
-    delay_us(1);
-    IO0CLR = (1 << LCD_E);
-    delay_us(100);
-    
-    lcd_cmd(LCD_FUNC_SET);
-    lcd_cmd(LCD_DISPLAY_ON);
-    lcd_cmd(LCD_CLEAR);
-    delay_ms(2);
-    lcd_cmd(LCD_ENTRY_MODE);
-}
-
-void lcd_print(const char *str) {
-    while(*str) lcd_data(*str++);
-}
 
 // Keypad Functions
 void keypad_init(void) {
@@ -139,19 +52,19 @@ void keypad_init(void) {
     );
     
     // Set rows as outputs
-    IO0DIR |= (
+    GPIO_DIR_OUT(
         (1 << KP_R1) | (1 << KP_R2) |
         (1 << KP_R3) | (1 << KP_R4)
     );
     
     // Set columns as inputs
-    IO0DIR &= ~(
+    GPIO_DIR_IN(
         (1 << KP_C1) | (1 << KP_C2) |
         (1 << KP_C3) | (1 << KP_C4)
     );
     
     // Set all rows HIGH initially
-    IO0SET = (
+    GPIO_SET(
         (1 << KP_R1) | (1 << KP_R2) |
         (1 << KP_R3) | (1 << KP_R4)
     );
@@ -207,7 +120,7 @@ char* int_to_string(int num) {
 void ADC_Init() {
     PINSEL1 |= (1 << 19);  // P0.25 as AD0.0 (Analog Input)
     ADCR = (1 << 21)      // Enable ADC (PDN = 1)
-          | (4 << 8);      // CLKDIV = 4 (for 2.4 MHz ADC clock @ 12 MHz PCLK)
+          | (4 << 8);      // CLKDIV = 4 (600 kHz ADC clock @ 3 MHz PCLK)
     delay_ms(1);           // ADC stabilization
 }
 
@@ -225,30 +138,30 @@ char keypad_scan(void) {
     int cols[] = {KP_C1, KP_C2, KP_C3, KP_C4};
     
     // Make sure all rows are HIGH initially
-    IO0CLR = (1 << KP_R1) | (1 << KP_R2) | (1 << KP_R3) | (1 << KP_R4);
+    GPIO_CLR((1 << KP_R1) | (1 << KP_R2) | (1 << KP_R3) | (1 << KP_R4));
     delay_ms(10);
     
     // Scan each row
     for(row = 0; row < 4; row++) {
         // Set only current row LOW
-        IO0SET = (1 << rows[row]);
+        GPIO_SET(1 << rows[row]);
         delay_ms(5);
         
         // Read all columns for this row
-        unsigned long cols_state = IO0PIN;
+        unsigned long cols_state = GPIO_READ();
         
         // Check each column
         for(col = 0; col < 4; col++) {
-            if((IO0PIN & (1 << cols[col]))) {
+            if((GPIO_READ() & (1 << cols[col]))) {
                 // Key pressed - verify
                 delay_ms(10);
-                if((IO0PIN & (1 << cols[col]))) {
+                if((GPIO_READ() & (1 << cols[col]))) {
                     // Wait for key release
-                    while((IO0PIN & (1 << cols[col])));
+                    while((GPIO_READ() & (1 << cols[col])));
                     delay_ms(10);  // Debounce release
                     
                     // Reset row to HIGH
-                    IO0SET = (1 << rows[row]);
+                    GPIO_SET(1 << rows[row]);
                     delay_ms(5);
                     return keymap[row][col];
                 }
@@ -256,7 +169,7 @@ char keypad_scan(void) {
         }
         
         // Set row back to HIGH before moving to next
-        IO0CLR = (1 << rows[row]);
+        GPIO_CLR(1 << rows[row]);
         delay_ms(5);
     }
     
@@ -264,24 +177,24 @@ char keypad_scan(void) {
 }
 
 int process_gain(int percent,int digVal){
-  if (digVal < (3.3*percent/100){
-    return 0
+  if (digVal < (3.3*percent/100)){
+    return 0;
   }
   else {
-    return 1
+    return 1;
   }
 }
 
-void PWM_Init() {
+void PWM_Init(int period) {
   // Step 1: Enable PWM Timer
   PWMPCR = (1 << 13);  // Enable PWM5 output (single-edge mode)
-  PWMPR = 0;           // No prescaler (PWM clock = PCLK = 12MHz)
+  PWMPR = 0;           // No prescaler (PWM clock = PCLK = 3 MHz)
   
-  // Step 2: Set PWM Frequency (e.g., 1kHz)
-  PWMMR0 = 12000 - 1;  // PWM frequency = PCLK / (PWMMR0 + 1) = 1kHz
+  // Step 2: Set PWM Frequency (e.g., 3000 -> 1kHz)
+  PWMMR0 = period - 1; // PWM frequency = PCLK / (PWMMR0 + 1)
   
-  // Step 3: Set Initial Duty Cycle (e.g., 50%)
-  PWMMR5 = 6000;       // Duty cycle = (PWMMR5 / PWMMR0) = 50%
+  // Step 3: Set Initial Duty Cycle (50%, the main loop takes over)
+  PWMMR5 = period / 2;  // Duty cycle = (PWMMR5 / PWMMR0)
   
   // Step 4: Enable PWM
   PWMTCR = (1 << 1);   // Reset PWM counter
@@ -300,42 +213,59 @@ void PWM_SetDuty(int duty_percent) {
 
 int main(void) {
     int threshold;
+    cfg_data cfg;
     
     char key;
     int pos = 0;
     
-    lcd_init();
+    init_lcd();
     keypad_init();
     
-    const char operations[] = "Threshold: ";
-    char inp_buf[4];
-    lcd_print(operations);
-    
-    lcd_cmd(LCD_CLEAR);
-    
-    while(1) {
-      key = keypad_scan();
-      if(key) {
-        if (key == '='){
-          threshold = array_to_int(inp_buf, pos);
-          break;          
+    // Settings from the last session start sampling at once; the keypad
+    // prompt runs when flash holds no valid record or 'O' is held at reset
+    key = keypad_scan();
+    if(cfg_load(&cfg) && key != 'O') {
+      threshold = cfg.threshold;
+    }
+    else {
+      const char operations[] = "Threshold: ";
+      char inp_buf[4];
+      lcd_print(operations);
+      
+      write_cmd(LCD_CLEAR);
+      
+      while(1) {
+        key = keypad_scan();
+        if(key) {
+          if (key == '='){
+            threshold = array_to_int(inp_buf, pos);
+            break;          
+          }
+          if(pos < 3) {
+            inp_buf[pos]=key;
+            pos++;
+            inp_buf[pos] = '\0';
+          }
         }
-        inp_buf[pos]=key;
-        pos++;
-        inp_buf[pos] = '\0';                
       }
+      cfg.threshold = threshold;
+      cfg_save(&cfg);
     }
     ADC_Init();
-    PWM_Init();
+    PWM_Init(cfg.pwm_period);
+    
+    // The voltage is shown as a bar on line 1; each sample rewrites only
+    // the cells that changed instead of clearing and reprinting the screen
+    lcd_bar bar;
+    write_cmd(LCD_CLEAR);
+    lcd_bar_load_glyphs();
+    lcd_bar_init(&bar, LCD_BAR_ROW1);
     while(1){
       int adc_val = ADC_Read(0);  // Read AD0.0 (P0.25)
       adc_val = adc_val * process_gain(threshold,adc_val);
       
       PWM_SetDuty(100*(adc_val/1023));
-      lcd_cmd(LCD_CLEAR);
-      
-      float voltage = (adc_val / 1023.0) * 3.3;
-      lcd_print(int_to_string(voltage));
+      lcd_bar_set(&bar, adc_val * LCD_BAR_STEPS / 1023);  // 0-3.3 V full scale
       
       delay_ms(100);  // Sample every 100ms (adjust as needed)
     } 